@@ -0,0 +1,69 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstddef>
+
+// ヒープ確保の計測: グローバルな operator new を置き換えて、ゲームスレッドでの確保回数とバイト数を
+// フレームごと・ゾーンごとに数える（ゲームループが確保をしていないことの確認用）
+// TRACK_ALLOCATIONS を定義してビルドした場合のみ operator new を置き換える（CMake の TRACK_ALLOCATIONS オプション）
+// それ以外のビルドでは何も数えず、IsAvailable() が false を返す
+// ゾーンとフレームの操作はゲームスレッドからだけ呼ぶ（他のスレッドの確保は数えない）
+class AllocationTracker {
+public:
+    // ゾーンごとの集計
+    struct ZoneStats {
+        const char* name;           // ゾーン名（文字列リテラル）
+        int frameAllocations;       // 直前のフレームの確保回数（このゾーン直下のみ）
+        size_t frameBytes;
+        int currentAllocations;     // 集計中のフレームの確保回数
+        size_t currentBytes;
+        Uint64 totalAllocations;    // 計測開始からの累計
+        Uint64 totalBytes;
+    };
+
+    // 数えられるゾーンの数・入れ子の深さ
+    static const int MAX_ZONES = 32;
+    static const int MAX_DEPTH = 16;
+
+    // operator new を置き換えてビルドされているか
+    static bool IsAvailable();
+
+    // 計測の有効化・無効化（呼び出したスレッドの確保だけを数える）
+    static void SetEnabled(bool enable);
+    static bool IsEnabled() { return enabled; }
+
+    // フレームの始め: 集計中のフレームを確定して、次のフレームの集計を始める
+    static void BeginFrame();
+    // 計測ゾーンの開始・終了（入れ子可、確保は最も内側のゾーンに数える）
+    static void BeginZone(const char* name);
+    static void EndZone();
+
+    // 直前のフレームの確保回数・バイト数
+    static int FrameAllocations() { return frameAllocations; }
+    static size_t FrameBytes() { return frameBytes; }
+    // ゾーンの集計（登録順）
+    static int ZoneCount() { return zoneCount; }
+    static const ZoneStats& Zone(int index) { return zones[index]; }
+
+    // 確保を1回数える（operator new から呼ばれる）
+    static void Count(size_t size);
+
+private:
+    static bool enabled;
+    static int frameAllocations;
+    static size_t frameBytes;
+    static int currentAllocations;
+    static size_t currentBytes;
+    // 集計の中で確保しないように固定長の配列で持つ
+    static ZoneStats zones[MAX_ZONES];
+    static int zoneCount;
+    static int zoneStack[MAX_DEPTH];
+    static int zoneDepth;               // MAX_DEPTH を超えた分は数えるだけで記録しない
+};
+
+// スコープの間を1つの確保計測ゾーンにするヘルパー
+class AllocationZone {
+public:
+    AllocationZone(const char* name) { AllocationTracker::BeginZone(name); }
+    ~AllocationZone() { AllocationTracker::EndZone(); }
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+// SDL_mixerが利用可能な場合のみ使用する
+#ifdef SOUND_ENABLED
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// オーディオアセット管理: 効果音のファイルをワーカースレッドで読み込み・デコードし、
+// パスごとに1つだけキャッシュする（BGMは MusicPlayer がファイルから少しずつ読む）
+// 要求するとすぐにハンドルが返り、準備ができるまで GetSound() は nullptr を返す（待たない）
+class AudioAssetManager {
+public:
+    // アセットのハンドル（-1=無効）
+    typedef int Handle;
+    static const Handle INVALID_HANDLE = -1;
+    // 登録できるアセットの最大数
+    static const int MAX_ASSETS = 64;
+
+    // コンストラクタ: ワーカースレッドを起動（Mix_OpenAudio の後に作る）
+    AudioAssetManager();
+    // デストラクタ: ワーカースレッドを停止し、読み込んだデータをすべて解放
+    ~AudioAssetManager();
+
+    // 効果音の読み込みを要求（同じパスは同じハンドルを返す）
+    Handle RequestSound(const std::string& path);
+
+    // 読み込み済みの効果音を取得（未完了・失敗・無効なハンドルは nullptr）
+    Mix_Chunk* GetSound(Handle handle) const;
+
+private:
+    // 1つのアセット（ハンドルで固定位置に置き、メインスレッドはロックせずに読む）
+    struct Asset {
+        std::string path;
+        std::atomic<Mix_Chunk*> chunk;
+    };
+
+    Asset assets[MAX_ASSETS];
+    std::atomic<int> assetCount;                        // 登録済みのアセット数
+    std::unordered_map<std::string, Handle> handles;    // パス → ハンドル（メインスレッドのみ）
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable workCondition;
+    std::deque<Handle> queue;                           // 読み込み待ちのハンドル
+    bool stopping;
+
+    // ワーカースレッドのメインループ
+    void WorkerLoop();
+};
+
+#endif  // SOUND_ENABLED
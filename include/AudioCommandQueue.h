@@ -0,0 +1,69 @@
+#pragma once
+
+// SDL_mixerが利用可能な場合のみ使用する
+#ifdef SOUND_ENABLED
+
+#include <SDL.h>
+#include <atomic>
+#include <cstddef>
+
+// オーディオコマンドの種類
+enum AudioCommandType {
+    AUDIO_PLAY_SOUND = 0,       // id=効果音のハンドル, value=優先度
+    AUDIO_PLAY_SOUND_AT,        // id=効果音のハンドル, value=優先度, x/y=音源のワールド座標
+    AUDIO_END_FRAME,            // value=フレームの時刻（SDL_GetTicks）, x/y=リスナーのワールド座標
+    AUDIO_SET_SOUND_VOLUME,     // value=音量（0-128）
+    AUDIO_SET_MUSIC_VOLUME,     // value=音量（0-128）
+    AUDIO_STOP_SOUNDS,
+    AUDIO_PLAY_MUSIC,           // id=BGMの曲番号
+    AUDIO_PREFETCH_MUSIC,       // id=BGMの曲番号
+    AUDIO_STOP_MUSIC
+};
+
+// オーディオコマンド（キューに入れるので小さく固定長にする）
+struct AudioCommand {
+    Uint32 type;
+    Sint32 id;
+    Uint32 value;
+    float x, y;
+};
+
+// オーディオコマンドのキュー: ゲームスレッド1つが積み、オーディオスレッド1つが取り出す（ロックなし）
+// 積む側のコストはスロットへの書き込みと atomic の読み書きだけ
+class AudioCommandQueue {
+public:
+    // スロット数（2の累乗）
+    static const size_t CAPACITY = 512;
+
+    AudioCommandQueue() : head(0), tail(0) {}
+
+    // 積む（ゲームスレッドのみ）。満杯なら false を返してコマンドを捨てる
+    bool Push(const AudioCommand& command) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (position - head.load(std::memory_order_acquire) >= CAPACITY) return false;
+        slots[position & (CAPACITY - 1)] = command;
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 取り出す（オーディオスレッドのみ）。空なら false
+    bool Pop(AudioCommand& command) {
+        size_t position = head.load(std::memory_order_relaxed);
+        if (position == tail.load(std::memory_order_acquire)) return false;
+        command = slots[position & (CAPACITY - 1)];
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    // 積む側と取り出す側が同じキャッシュラインを奪い合わないように離して置く
+    alignas(64) std::atomic<size_t> head;   // 次に取り出す位置（オーディオスレッドが進める）
+    alignas(64) std::atomic<size_t> tail;   // 次に積む位置（ゲームスレッドが進める）
+    alignas(64) AudioCommand slots[CAPACITY];
+
+    // コピー禁止
+    AudioCommandQueue(const AudioCommandQueue&) = delete;
+    AudioCommandQueue& operator=(const AudioCommandQueue&) = delete;
+};
+
+#endif  // SOUND_ENABLED
@@ -0,0 +1,86 @@
+#pragma once
+
+// SDL_mixerが利用可能な場合のみ使用する
+#ifdef SOUND_ENABLED
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <string>
+#include <unordered_map>
+#include <atomic>
+#include <thread>
+
+#include "AudioCommandQueue.h"
+#include "AudioAssetManager.h"
+#include "SoundMixer.h"
+#include "MusicPlayer.h"
+
+// オーディオスレッド: ゲームスレッドが積んだコマンドを取り出して SDL_mixer を操作する
+// 効果音チャンネルの Mix_* の呼び出し（と SDL_mixer 内部のロック待ち）はすべてこのスレッドで行い、
+// ゲームスレッドの効果音1回あたりのコストはキューへの書き込みだけにする
+// BGMのコマンド（音量を含む）は MusicPlayer に渡し、音楽チャンネルはBGMスレッドだけが操作する
+class AudioThread {
+public:
+    // BGMの曲番号（-1=無効）
+    typedef int MusicTrack;
+    static const MusicTrack INVALID_TRACK = -1;
+    // 登録できるBGMの最大数
+    static const int MAX_MUSIC_TRACKS = 32;
+    // キューが空の時に待つ時間（ミリ秒）
+    static const int IDLE_SLEEP_MS = 1;
+
+    // コンストラクタ: 効果音ミキサーを作り、オーディオスレッドを起動（Mix_OpenAudio の後に作る）
+    AudioThread(AudioAssetManager* assets, MusicPlayer* musicPlayer);
+    // デストラクタ: 残りのコマンドを実行してからスレッドを終了し、すべての効果音を止める
+    ~AudioThread();
+
+    // === ゲームスレッドから呼ぶ（コマンドを積むだけ） ===
+    void PlaySound(AudioAssetManager::Handle sound, int priority);
+    // 位置つきの効果音（ワールド座標、リスナーからの距離で減衰・定位する）
+    void PlaySoundAt(AudioAssetManager::Handle sound, int priority, float x, float y);
+    // フレームの終わり（リスナーの位置を更新し、このフレームの効果音をまとめて鳴らす）
+    void EndFrame(Uint32 now, float listenerX, float listenerY);
+    void SetSoundVolume(int volume);
+    void SetMusicVolume(int volume);
+    void StopSounds();
+    // BGMの曲番号を取得（初めてのパスは登録する）
+    MusicTrack RegisterMusic(const std::string& path, const std::string& fallbackPath = "");
+    void PlayMusic(MusicTrack track);
+    void PrefetchMusic(MusicTrack track);
+    void StopMusic();
+
+    // キューが満杯で捨てたコマンドの数
+    int DroppedCommands() const { return droppedCommands.load(std::memory_order_relaxed); }
+
+private:
+    // 登録したBGM（登録後は変更しないので、オーディオスレッドからロックなしで読める）
+    struct MusicEntry {
+        std::string path;
+        std::string fallbackPath;
+    };
+
+    AudioCommandQueue queue;
+    MusicPlayer* musicPlayer;
+    SoundMixer* mixer;                  // オーディオスレッドだけが触る
+    std::thread worker;
+    std::atomic<bool> stopping;
+    std::atomic<int> droppedCommands;
+
+    MusicEntry musicEntries[MAX_MUSIC_TRACKS];
+    std::atomic<int> musicCount;
+    std::unordered_map<std::string, MusicTrack> musicTracks;   // パス→曲番号（ゲームスレッドのみ）
+
+    // コマンドを積む（満杯なら捨てて数える）
+    void Push(AudioCommandType type, int id = 0, Uint32 value = 0, float x = 0.0f, float y = 0.0f);
+    // オーディオスレッドのメインループ
+    void WorkerLoop();
+    // コマンドを1つ実行
+    void Execute(const AudioCommand& command);
+    const MusicEntry* GetMusic(MusicTrack track) const;
+
+    // コピー禁止
+    AudioThread(const AudioThread&) = delete;
+    AudioThread& operator=(const AudioThread&) = delete;
+};
+
+#endif  // SOUND_ENABLED
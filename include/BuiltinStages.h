@@ -0,0 +1,28 @@
+#pragma once
+
+#include <SDL.h>
+
+#include "Goal.h"
+#include "StageFormat.h"
+
+// 組み込みステージ: コンパイル時に作ったタイル層と配置表（読み取り専用メモリに置かれる）
+// ステージファイル（assets/stages/*.stg）が無い時に使う
+struct BuiltinStage {
+    int stageNumber;                // ステージ番号
+    const char* name;               // ステージ名
+    GoalType goalType;              // ゴールの種類
+    int goalX, goalY;               // ゴール位置
+    int playerStartX, playerStartY; // プレイヤー開始位置
+    int timeLimit;                  // 制限時間（秒、0=無制限）
+    const char* bgmFile;            // BGMファイル名（空文字=既定のBGM）
+    int width, height;              // タイル単位のサイズ
+    const Uint8* tiles;             // タイル層（1タイル1バイト、行優先）
+    const StageFileSpawn* enemies;  // 敵の配置（種類を含む）
+    int enemyCount;
+    const StageFileSpawn* items;    // アイテムの配置
+    int itemCount;
+};
+
+// 組み込みステージの一覧と数
+extern const BuiltinStage BUILTIN_STAGES[];
+extern const int BUILTIN_STAGE_COUNT;
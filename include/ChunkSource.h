@@ -0,0 +1,64 @@
+#pragma once
+
+#include <SDL.h>
+#include <string>
+#include <vector>
+
+#include "TileGrid.h"
+
+// 敵・アイテムの配置情報（ワールド座標のピクセル位置と種類）
+struct ChunkSpawn {
+    int x, y;
+    int type;   // EnemyType または ItemType
+};
+
+// ストリーミングするステージ全体の情報
+struct LevelInfo {
+    int chunkWidth;                     // 1チャンクの幅（タイル単位）
+    int chunkCount;                     // チャンク数
+    int width;                          // ステージ全体の幅（タイル単位、最後のチャンクは途中まで）
+    int height;                         // ステージの高さ（タイル単位）
+    int playerStartX, playerStartY;     // プレイヤー開始位置
+    int goalX, goalY;                   // ゴール位置
+    int goalType;                       // GoalType
+    int timeLimit;                      // 制限時間（秒、0=無制限）
+};
+
+// 1チャンク分のデータ（固定幅の列とその範囲に置かれた敵・アイテム）
+struct LevelChunk {
+    int index;                          // チャンク番号
+    std::vector<Uint8> tiles;           // chunkWidth x height のタイル（行優先）
+    std::vector<ChunkSpawn> enemies;    // 敵の初期配置
+    std::vector<ChunkSpawn> items;      // アイテムの初期配置
+};
+
+// チャンクの読み込み元（ファイル以外の生成元にも差し替えられるようにする）
+// LoadChunk はストリーミングの読み込みスレッドから呼ばれる
+class ChunkSource {
+public:
+    virtual ~ChunkSource() {}
+    // ステージ全体の情報を読み込む
+    virtual bool ReadInfo(LevelInfo& info) = 0;
+    // 指定番号のチャンクを読み込む
+    virtual bool LoadChunk(int index, LevelChunk& chunk) = 0;
+};
+
+// ディレクトリ内のチャンクファイル（level.dat + chunk_NNNN.dat）から読み込む
+class FileChunkSource : public ChunkSource {
+public:
+    // コンストラクタ: チャンクファイルのあるディレクトリを指定
+    FileChunkSource(const std::string& directory);
+
+    bool ReadInfo(LevelInfo& info) override;
+    bool LoadChunk(int index, LevelChunk& chunk) override;
+
+    // ステージ全体をチャンクファイルに書き出す（info.chunkWidth ごとに分割）
+    static bool WriteLevel(const std::string& directory, const LevelInfo& info, const TileGrid& tiles,
+                           const std::vector<ChunkSpawn>& enemies, const std::vector<ChunkSpawn>& items);
+
+private:
+    std::string directory;
+
+    // チャンクファイルのパス
+    static std::string ChunkPath(const std::string& directory, int index);
+};
@@ -18,6 +18,9 @@ struct ColorPalette {
     static const SDL_Color TILE_MAIN;            // タイルメイン色
     static const SDL_Color TILE_EDGE;            // タイルエッジ色
     static const SDL_Color TILE_SHADOW;          // タイル影色
+    static const SDL_Color TILE_PLATFORM;        // すり抜け床の色
+    static const SDL_Color TILE_HAZARD;          // トゲの色
+    static const SDL_Color TILE_ICE;             // 氷の色
     
     // UI色
     static const SDL_Color UI_PRIMARY;           // UIメイン色
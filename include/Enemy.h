@@ -3,6 +3,8 @@
 #include <SDL.h>
 #include <cmath>
 
+#include "TileGrid.h"
+
 // 敵の種類を定義する列挙型
 enum EnemyType {
     ENEMY_GOOMBA = 0,    // 基本的な歩行敵（クリボー風）
@@ -82,13 +84,13 @@ public:
     Enemy(int x, int y, EnemyType type);
     
     // 敵の状態を1フレーム分更新
-    void Update(int playerX, int playerY, int map[19][100]);
+    void Update(int playerX, int playerY, const TileGrid& map);
     
     // AI更新処理
     void UpdateAI(int playerX, int playerY);
     
     // 移動更新処理
-    void UpdateMovement(int map[19][100]);
+    void UpdateMovement(const TileGrid& map);
     
     // 攻撃更新処理
     void UpdateAttack();
@@ -105,6 +107,6 @@ public:
     // プレイヤーまでの距離を計算
     float DistanceToPlayer(int playerX, int playerY);
     
-    // プレイヤーが見えるかチェック
-    bool CanSeePlayer(int playerX, int playerY, int map[19][100]);
+    // プレイヤーが見えるかチェック（mapはnullptrでもよい）
+    bool CanSeePlayer(int playerX, int playerY, const TileGrid* map);
 }; 
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// フレームアリーナ: 1フレームの間だけ使う一時データ用の線形アロケータ
+// 確保はポインタを進めるだけで、個別の解放はしない（フレームの始めに Reset でまとめて捨てる）
+// 容量が足りない時はヒープから確保してそのフレームを乗り切り、次の Reset で容量を広げる
+// （最初の数フレームで容量が決まり、その後はヒープを使わない）
+class FrameArena {
+public:
+    // 最初に用意する容量（バイト）
+    static const size_t DEFAULT_CAPACITY = 64 * 1024;
+    // 既定のアラインメント
+    static const size_t DEFAULT_ALIGNMENT = alignof(std::max_align_t);
+
+    explicit FrameArena(size_t capacity = DEFAULT_CAPACITY);
+    ~FrameArena();
+
+    // size バイトを確保する（フレームの終わりまで有効）
+    void* Allocate(size_t size, size_t alignment = DEFAULT_ALIGNMENT);
+    // printf 形式で文字列を作る（フレームの終わりまで有効）
+    const char* Format(const char* format, ...);
+    // フレームの始め: 前のフレームの確保をすべて捨てる
+    void Reset();
+
+    size_t Capacity() const { return capacity; }
+    size_t Used() const { return used; }
+    // 容量が足りずにヒープから確保した回数（累計）
+    int OverflowCount() const { return overflowCount; }
+
+private:
+    // 容量が足りない時にヒープから確保したブロック（次の Reset で解放する）
+    struct OverflowBlock {
+        OverflowBlock* next;
+    };
+
+    char* buffer;
+    size_t capacity;
+    size_t used;
+    size_t overflowBytes;           // このフレームでヒープから確保したバイト数
+    OverflowBlock* overflowBlocks;
+    int overflowCount;
+
+    // コピー禁止
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+};
+
+// フレームアリーナから確保する STL アロケータ（解放は何もしない）
+template <typename T>
+class FrameAllocator {
+public:
+    typedef T value_type;
+
+    FrameAllocator(FrameArena* arena) : arena(arena) {}
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t count) { return (T*)arena->Allocate(count * sizeof(T), alignof(T)); }
+    void deallocate(T*, size_t) {}
+
+    FrameArena* arena;
+};
+
+template <typename T, typename U>
+bool operator==(const FrameAllocator<T>& a, const FrameAllocator<U>& b) { return a.arena == b.arena; }
+template <typename T, typename U>
+bool operator!=(const FrameAllocator<T>& a, const FrameAllocator<U>& b) { return a.arena != b.arena; }
+
+// フレームの間だけ使う文字列・配列
+typedef std::basic_string<char, std::char_traits<char>, FrameAllocator<char>> FrameString;
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
@@ -20,14 +20,39 @@
 #include <string>
 // C++標準ライブラリ: ファイル入出力
 #include <fstream>
+// C++標準ライブラリ: 起動時の並列読み込み用スレッド
+#include <thread>
 
 // 分離されたクラスファイルをインクルード
 #include "ColorPalette.h"
 #include "Item.h"
 #include "Goal.h"
 #include "Particle.h"
+#include "TileGrid.h"
 #include "Enemy.h"
 #include "Boss.h"
+#include "SpatialGrid.h"
+#include "RenderProfiler.h"
+#include "ParticleRasterizer.h"
+#include "LightMap.h"
+#include "LevelStreamer.h"
+#include "MappedStage.h"
+#include "StageData.h"
+#include "BuiltinStages.h"
+#include "StageGenerator.h"
+#include "StageWatcher.h"
+#include "StagePreloader.h"
+#include "StageSnapshot.h"
+#include "StartupProfiler.h"
+#include "InputBuffer.h"
+#include "InputRecorder.h"
+#include "LatencyTracker.h"
+#include "FrameArena.h"
+#include "AllocationTracker.h"
+#include "AudioAssetManager.h"
+#include "SoundMixer.h"
+#include "MusicPlayer.h"
+#include "AudioThread.h"
 
 // 衝突の種類を定義する列挙型
 enum CollisionType {
@@ -39,30 +64,13 @@ enum CollisionType {
 
 
 
-// ステージデータ構造体
-struct StageData {
-    int stageNumber;                                    // ステージ番号
-    std::string stageName;                              // ステージ名
-    int mapData[19][100];                              // マップデータ（横スクロール対応）
-    std::vector<std::pair<int, int>> enemyPositions;   // 敵の初期位置リスト
-    std::vector<std::pair<std::pair<int, int>, ItemType>> itemPositions; // アイテム位置と種類
-    GoalType goalType;                                  // ゴールの種類
-    int goalX, goalY;                                   // ゴール位置
-    int playerStartX, playerStartY;                     // プレイヤー開始位置
-    int timeLimit;                                      // 制限時間（秒、0=無制限）
-    std::string bgmFile;                                // BGMファイル名
-    
-    // コンストラクタ
-    StageData() : stageNumber(1), stageName("Stage 1"), goalType(GOAL_FLAG), 
-                  goalX(0), goalY(0), playerStartX(100), playerStartY(300), 
-                  timeLimit(0), bgmFile("") {
-        // マップを初期化（空で埋める）
-        for (int y = 0; y < 19; y++) {
-            for (int x = 0; x < 25; x++) {
-                mapData[y][x] = 0;
-            }
-        }
-    }
+// タイルの隣接マスク（上下左右に同じブロックがあるかを4bitで表す）
+enum TileNeighborMask {
+    TILE_MASK_TOP = 1,      // 上にブロックがある
+    TILE_MASK_BOTTOM = 2,   // 下にブロックがある
+    TILE_MASK_LEFT = 4,     // 左にブロックがある
+    TILE_MASK_RIGHT = 8,    // 右にブロックがある
+    TILE_MASK_VARIANTS = 16 // マスクの組み合わせ数（アトラスのセル数）
 };
 
 
@@ -70,6 +78,7 @@ struct StageData {
 
 
 
+
 // ゲーム全体を管理するメインクラス
 class Game {
 public:  // 外部から呼び出せるメンバ（パブリック）
@@ -81,15 +90,38 @@ public:  // 外部から呼び出せるメンバ（パブリック）
     // ゲーム初期化関数: ウィンドウ作成、SDL初期化などを行う
     // title: ウィンドウのタイトル, x,y: ウィンドウ位置, width,height: ウィンドウサイズ, fullscreen: フルスクリーンかどうか
     bool Initialize(const char* title, int x, int y, int width, int height, bool fullscreen);
-    // イベント処理関数: キーボード入力、マウス操作、ウィンドウ閉じるボタンなどを処理
+    // イベント処理関数: ウィンドウ閉じるボタンなどを処理し、キーとボタンの入力を入力バッファに記録する
     void HandleEvents();
-    // ゲーム状態更新関数: プレイヤー位置、敵の動き、衝突判定などの計算を行う
+    // ゲーム状態更新関数: 経過時間の分だけ固定ステップのティック（入力処理・プレイヤー・敵・衝突判定など）を進める
     void Update();
     // 描画関数: 画面をクリアして、すべてのゲームオブジェクトを描画する
     void Render();
     // 終了処理関数: SDL関連のリソースを解放、メモリクリーンアップ
     void Clean();
     
+    // オフスクリーン初期化関数: ウィンドウを作らず、サーフェスに描画するソフトウェアレンダラーを作成する
+    // ベンチマークやCIなど、ハードウェア描画が使えない環境向け
+    bool InitializeHeadless(int width, int height);
+    // 描画ベンチマーク: 決定的なシーンをframesフレーム分描画し、描画統計を出力する
+    // printChecksum: 最終フレームの画像ハッシュを出力するかどうか
+    void RunRenderBenchmark(int frames, bool printChecksum);
+    // CPUパーティクル描画を常に使用し、パーティクル上限数をlimitに引き上げる（大量パーティクル用）
+    void EnableCpuParticles(int limit);
+    // チャンクファイルのディレクトリをストリーミングステージとして追加し、最初に遊ぶステージにする
+    bool AddStreamedStage(const std::string& directory);
+    // ステージをチャンクファイルに書き出す（ストリーミング用）
+    bool ExportStage(int stageIndex, const std::string& directory);
+    // シード値から手続き生成する果てしないステージを追加し、最初に遊ぶステージにする
+    void AddGeneratedStage(Uint32 seed);
+    // ジャンプ・ダッシュ・攻撃の押下を保持する時間（ミリ秒、ティック数に切り上げる）
+    void SetInputBufferWindow(Uint32 milliseconds);
+    // ティックごとの操作をファイルに記録する・ファイルから再生する（Initialize の前に呼ぶ）
+    bool StartInputRecording(const std::string& path);
+    bool StartInputReplay(const std::string& path);
+    // 確保のチェック: 記録した操作をオフスクリーンで再生し、warmupFrames フレーム以降の
+    // Update・Render でヒープ確保があれば失敗する（InitializeHeadless の後に呼ぶ、TRACK_ALLOCATIONS ビルドのみ）
+    bool RunAllocationCheck(const std::string& replayPath, int warmupFrames);
+    
     // ゲーム実行状態を確認する関数（const = この関数は内部データを変更しない）
     bool Running() const { return isRunning; }
     
@@ -101,6 +133,8 @@ private:  // クラス内部でのみアクセス可能なメンバ（プライ
     bool isRunning;
     // SDL2のウィンドウオブジェクトへのポインタ
     SDL_Window* window;
+    // オフスクリーン描画先のサーフェス（InitializeHeadless使用時のみ）
+    SDL_Surface* headlessSurface;
     
     // === プレイヤー関連 ===
     // プレイヤーキャラクターのX, Y座標（画面上の位置）
@@ -184,6 +218,10 @@ private:  // クラス内部でのみアクセス可能なメンバ（プライ
     // パーティクルシステム
     std::vector<Particle> particles; // パーティクル配列
     int particleLimit;               // パーティクル上限数
+    ParticleRasterizer* particleRasterizer; // CPUパーティクル描画（大量時のみ使用、必要になった時に作成）
+    bool forceCpuParticles;          // 数に関係なくCPUパーティクル描画を使うか
+    static const int CPU_PARTICLE_THRESHOLD = 2000; // CPU描画に切り替える可視パーティクル数
+    static const int PROJECTILE_RESERVE = 64;       // 弾丸配列にあらかじめ確保しておく数
     
     // 画面シェイクシステム
     int screenShakeIntensity;        // シェイクの強度
@@ -200,14 +238,18 @@ private:  // クラス内部でのみアクセス可能なメンバ（プライ
     float playerGlowTimer;           // 光のアニメーションタイマー
     
     // 環境効果
-    float ambientDarkness;           // 環境の暗さ
-    bool enableShadows;              // 影の有効化
+    float ambientDarkness;           // 環境の暗さ（ライトマップの環境光 = 1 - ambientDarkness）
+    bool enableShadows;              // 影の有効化（ライトマップのブロック遮蔽にも使用）
+    LightMap* lightMap;              // 1/4解像度のライトマップ（初回描画時に作成）
+    static const int LIGHTMAP_SCALE = 4; // ライトマップの縮小率
     
     // === 物理システム（マリオ風ジャンプアクション用） ===
     // Y方向の速度（浮動小数点で精密な物理計算）
     float playerVelY;
     // 重力の強さ（毎フレーム速度に加算される）
     float gravity;
+    // 通常ジャンプの初速度（上向き、ピクセル/フレーム）
+    static constexpr float JUMP_VELOCITY = 15.0f;
     // プレイヤーが地面に接触しているかのフラグ
     bool isOnGround;
     // ジャンプ中かどうかのフラグ
@@ -231,9 +273,44 @@ private:  // クラス内部でのみアクセス可能なメンバ（プライ
     // フレームカウンター（60フレーム = 1秒）
     int frameCounter;
     
+    // === 固定ステップのシミュレーション ===
+    // 1秒あたりのティック数（ゲームロジックはフレーム単位で調整されているので60のまま）
+    static const int TICKS_PER_SECOND = 60;
+    static constexpr double TICK_MS = 1000.0 / TICKS_PER_SECOND;
+    // 1回の Update で進める最大ティック数（これを超えた遅れは捨てる）
+    static const int MAX_TICKS_PER_UPDATE = 5;
+    // スティックを方向の操作とみなす傾き（-1.0～1.0）
+    static constexpr float STICK_THRESHOLD = 0.3f;
+    // シミュレーションの時刻（ミリ秒、SDL_GetTicks と同じ基準）
+    double simulationTime;
+    bool simulationStarted;
+    // パフォーマンス表示（F3で切り替え: フレーム時間とヒープ確保の回数）
+    bool showPerfOverlay;
+    Uint64 lastFrameCounter;        // 前のフレームの描画開始時刻（パフォーマンスカウンタ）
+    double frameMilliseconds;       // 前のフレームからの時間
+    void RenderPerfOverlay();
+    // フレームアリーナ（UIの文字列など、1フレームの間だけ使う一時データ用。フレームの始めに捨てる）
+    FrameArena frameArena;
+    // 入力バッファ（キーとボタンのイベントをタイムスタンプ付きで記録し、ティックごとに操作に変換する）
+    InputBuffer inputBuffer;
+    // このティックの操作（ゲームプレイの入力処理はキー・ボタンではなくこれだけを読む）
+    ActionFrame actions;
+    // 操作の記録・再生
+    InputRecorder inputRecorder;
+    
+    // 1ティック分の入力処理とゲームロジック
+    void Tick(Uint32 time);
+    void HandleInput();
+    // このティックの操作を作る（スティックの読み取り、再生・記録）
+    void SampleActions(Uint32 time);
+    // ゲームプレイ中の入力処理（キーボード・コントローラー共通）
+    void HandleGameplayInput();
+    
     // === UIシステム（画面上のテキスト表示） ===
     // フォントファイルのポインタ
     TTF_Font* font;
+    // フォントを読み込むスレッド（起動時にウィンドウ作成と並行して読み込む）
+    std::thread fontLoader;
     // UIの描画エリア（画面上部）
     SDL_Rect uiArea;
     // UI背景色の透明度
@@ -241,25 +318,28 @@ private:  // クラス内部でのみアクセス可能なメンバ（プライ
     
     // === サウンドシステム ===
 #ifdef SOUND_ENABLED
-    // 効果音データ
-    Mix_Chunk* jumpSound;
-    Mix_Chunk* coinSound;
-    Mix_Chunk* powerUpSound;
-    Mix_Chunk* enemyDefeatedSound;
-    Mix_Chunk* damageSound;
-    // BGM
-    Mix_Music* backgroundMusic;
+    // オーディオアセット管理（ファイルの読み込み・デコードとキャッシュ）
+    AudioAssetManager* audioAssets;
+    // オーディオスレッド（効果音・BGM・音量の操作をコマンドとして受け取り、SDL_mixer を操作する）
+    AudioThread* audioThread;
+    // 効果音データ（オーディオアセットのハンドル）
+    AudioAssetManager::Handle jumpSound;
+    AudioAssetManager::Handle coinSound;
+    AudioAssetManager::Handle powerUpSound;
+    AudioAssetManager::Handle enemyDefeatedSound;
+    AudioAssetManager::Handle damageSound;
+    AudioAssetManager::Handle enemyShootSound;
+    // BGMプレイヤー（ステージごとの曲をファイルから少しずつ読みながら再生する）
+    MusicPlayer* musicPlayer;
 #endif
     // サウンドが有効かどうか
     bool soundEnabled;
+    // 最初のフレームの表示後に回した起動処理が残っているか
+    bool startupPending;
     
     // === マップシステム（タイルベースのステージ） ===
-    // マップの幅（タイル単位）- 横スクロール対応で大幅拡張
-    static const int MAP_WIDTH = 100;  // 25 → 100 に拡張
-    // マップの高さ（タイル単位）
-    static const int MAP_HEIGHT = 19;
     // 1タイルのピクセルサイズ
-    static const int TILE_SIZE = 32;
+    static const int TILE_SIZE = TileGrid::TILE_SIZE;
     
     // === カメラシステム ===
     float cameraX;                      // カメラのX座標
@@ -284,16 +364,30 @@ private:  // クラス内部でのみアクセス可能なメンバ（プライ
     float titleGlowEffect;          // タイトルの光エフェクト
     bool showPressAnyKey;           // "Press Any Key"の点滅表示
     
-    // マップデータ（2次元配列: 0=空、1=地面ブロック）
-    int map[MAP_HEIGHT][MAP_WIDTH];
+    // マップデータ（1タイル1バイト: 0=空、1=地面ブロック）
+    TileGrid map;
+    // タイルの隣接マスク（TileNeighborMaskの組み合わせ、ステージ読み込み時に計算）
+    TileGrid tileMasks;
+    // 隣接マスク16種類を焼き込んだタイルアトラス（1セル = TILE_SIZE x (TILE_SIZE + 影の高さ)）
+    SDL_Texture* tileAtlas;
+    static const int TILE_SHADOW_HEIGHT = 4;  // タイル下の影の高さ
     
     // === ステージシステム ===
     // ステージデータの配列
     std::vector<StageData> stages;
     int currentStageIndex;  // 現在のステージ番号
+    int firstStageIndex;    // 新しいゲームで最初に遊ぶステージ番号
+    // ストリーミング中のステージ（カメラ周辺のチャンクだけを常駐させる、通常のステージではnullptr）
+    LevelStreamer* levelStreamer;
+    // 次のステージを裏で準備する先読み（最初の先読み要求時に作成）
+    StagePreloader* stagePreloader;
+    // 読み込み直後のステージ状態（リスタートはここからの一括コピーで済ませる）
+    StageSnapshot stageSnapshot;
+    // ステージファイルの変更監視（ステージファイルを読み込んだ場合のみ）
+    StageWatcher* stageWatcher;
+    static const int STREAM_CHUNK_WIDTH = 32;  // 書き出し時の1チャンクの幅（タイル単位、画面幅より広くする）
     Goal* goal;             // ゴールオブジェクトへのポインタ
     bool stageCleared;      // ステージクリアフラグ
-    bool isTransitioning;   // ステージ遷移中フラグ
     int remainingTime;      // ステージの制限時間
     bool allStagesCleared;  // 全ステージクリアフラグ
     
@@ -314,7 +408,13 @@ private:  // クラス内部でのみアクセス可能なメンバ（プライ
     // アイテムの配列（複数のアイテムを管理）
     std::vector<Item> items;
     std::vector<EnemyProjectile> enemyProjectiles;  // 敵の弾丸リスト
-
+    
+    // === 描画カリングシステム ===
+    static const int RENDER_CELL_SIZE = 128;  // 空間インデックスのセルサイズ（ピクセル）
+    SpatialGrid staticRenderIndex;   // 動かない描画対象（アイテム）の索引（ステージ読み込み時に構築）
+    SpatialGrid dynamicRenderIndex;  // 動く描画対象（敵・弾丸・パーティクル）の索引（毎フレーム再構築）
+    VisibleLists visibleLists;       // 今フレームの可視リスト（レイヤー別のインデックス）
+    SDL_Rect viewRect;               // 今フレームのカメラ矩形（全レイヤー共通のスナップショット）
     
     // === プライベートメソッド（内部処理用） ===
     // 衝突判定処理: プレイヤーと地面・プラットフォームの衝突をチェック（垂直方向）
@@ -339,8 +439,6 @@ private:  // クラス内部でのみアクセス可能なメンバ（プライ
     void DisplayGameStatus();
     
     // === アイテムシステムメソッド ===
-    // アイテムシステムの初期化（アイテムの配置）
-    void InitializeItems();
     // プレイヤーとアイテムの衝突判定
     bool CheckPlayerItemCollision(const Item& item);
     // アイテム取得時の処理
@@ -373,6 +471,8 @@ private:  // クラス内部でのみアクセス可能なメンバ（プライ
     
     // 戦闘システム
     void HandleAttack();                         // 攻撃処理
+    void HandleAttackInput();                    // 攻撃ボタンの入力処理（バッファされた押下）
+    void HandleJumpInput();                      // ジャンプボタンの入力処理（バッファされた押下）
     void UpdateAttack();                         // 攻撃状態の更新
     void StartAttack();                          // 攻撃開始
     void EndAttack();                            // 攻撃終了
@@ -386,6 +486,7 @@ private:  // クラス内部でのみアクセス可能なメンバ（プライ
     void EndBeamAttack();                        // 光線攻撃終了
     bool CheckBeamHit(const Enemy& enemy);       // 光線ヒット判定
     void RenderBeam();                           // 光線描画
+    SDL_Color GetBeamColor();                    // チャージ時間に応じた光線の色
     
     // ウォールジャンプシステム
     void HandleWallJump();                       // ウォールジャンプ処理
@@ -417,6 +518,7 @@ private:  // クラス内部でのみアクセス可能なメンバ（プライ
     void RenderParticles();                      // パーティクルの描画
     void SpawnParticle(float x, float y, float velX, float velY, ParticleType type, float life = 60.0f);
     void SpawnParticleBurst(float x, float y, ParticleType type, int count = 10); // パーティクル大量生成
+    void ReserveParticles();                                 // パーティクル用の配列を上限に合わせて確保
     void CreateDashTrail();                      // ダッシュ軌跡生成
     void CreateAttackEffect();                   // 攻撃エフェクト生成
     void CreateEnemyDeathEffect(float x, float y); // 敵死亡エフェクト
@@ -434,12 +536,20 @@ private:  // クラス内部でのみアクセス可能なメンバ（プライ
     
     // プレイヤー描画強化
     void RenderEnhancedPlayer();                 // 美化されたプレイヤー描画
-    void RenderPlayerGlow();                     // プレイヤーの光エフェクト
+    void RenderLighting();                       // 光源をライトマップに集めてシーンに乗算
     
     // 環境描画強化
     void RenderEnhancedTiles();                  // 美化されたタイル描画
-    void RenderTileShadows();                    // タイルの影描画
-    void RenderTile(int x, int y, bool hasTop, bool hasBottom, bool hasLeft, bool hasRight);
+    void RenderTileShadow(int x, int y);         // タイル下端の影描画
+    void RenderTile(int x, int y, Uint8 mask);   // 個別タイルの描画（mask: 隣接マスク）
+    void RenderTileVariant(int x, int y, Uint8 variant, Uint8 mask); // 描画バリエーションごとのタイル描画
+    void ComputeTileMasks();                     // 全タイルの隣接マスクを計算（ステージ読み込み時）
+    void UpdateTileMasksAround(int tileX, int tileY); // 変更されたタイルと上下左右のマスクを再計算
+    static void UpdateTileMasksAround(const TileGrid& tiles, TileGrid& masks, int tileX, int tileY);
+    // 全タイル・1タイル分の隣接マスクを計算（先読みスレッドからも使うため静的）
+    static void ComputeTileMasks(const TileGrid& tiles, TileGrid& masks);
+    static Uint8 ComputeTileMask(const TileGrid& tiles, int tileX, int tileY);
+    bool BuildTileAtlas();                       // 描画バリエーション x 16種類のタイルをアトラステクスチャに焼き込む
     
     // UI描画強化
     void RenderEnhancedUI();                     // 美化されたUI描画
@@ -454,8 +564,30 @@ private:  // クラス内部でのみアクセス可能なメンバ（プライ
     // === ステージシステムメソッド ===
     // ステージシステムの初期化
     void InitializeStages();
+    // ステージファイルをマップしてステージ一覧に追加（ヘッダの値だけを読む）
+    bool AddStageFile(const std::string& path);
+    // ステージデータにステージファイルの内容を設定（タイル層と配置表はファイルを直接指す）
+    static void ApplyStageFile(StageData& stage, const std::shared_ptr<MappedStage>& file);
+    // 変更されたステージファイルを読み直す（遊んでいるステージは変わったタイルだけを差し替える）
+    void PollStageReload();
+    void ReloadStageFile(int stageIndex);
+    // 組み込みステージをステージ一覧に追加（静的テーブルを指すだけ）
+    void AddBuiltinStage(const BuiltinStage& builtin);
     // 現在のステージを読み込み
     void LoadStage(int stageIndex);
+    // カメラ位置に合わせてストリーミングのウィンドウを更新
+    void UpdateLevelStreaming();
+    // プレイヤーの移動能力（ジャンプ・ダッシュ・壁登りのパラメータ）をタイル単位に換算
+    PlayerReach ComputePlayerReach() const;
+    // ステージの実行時状態（マップ・マスク・敵・アイテム・ゴール・索引）を作る（先読みスレッドで実行）
+    static PreparedStage* BuildPreparedStage(const StageData& stage);
+    // 指定したステージの先読みを開始（ストリーミングステージは対象外）
+    void PreloadStage(int stageIndex);
+    // ステージ開始時のプレイヤー・タイマー・ボス戦の状態を設定（読み込みとリスタートで共通）
+    void ResetStageState(int stageIndex);
+    // 読み込み直後のステージ状態をスナップショットに保存・書き戻し
+    void CaptureStageSnapshot(int stageIndex);
+    void RestoreStageSnapshot();
     // 次のステージに進む
     void NextStage();
     // ステージをリセット（再スタート）
@@ -466,12 +598,6 @@ private:  // クラス内部でのみアクセス可能なメンバ（プライ
     void HandleStageClear();
     // ゴールの描画処理
     void RenderGoal();
-    // ステージデータの作成（個別ステージ）
-    StageData CreateStage1();
-    StageData CreateStage1Long();           // 横スクロール対応の長いステージ1
-    StageData CreateStage2();
-    StageData CreateStage3();
-    StageData CreateBossStage();                 // ボスステージの作成
     // 制限時間の更新
     void UpdateTimeLimit();
     // ステージクリア条件のチェック
@@ -494,35 +620,46 @@ private:  // クラス内部でのみアクセス可能なメンバ（プライ
 #ifdef SOUND_ENABLED
     // サウンドシステムの初期化
     bool InitializeSound();
-    // サウンドの読み込み
-    bool LoadSounds();
+    // サウンドの読み込みを要求（デコードはオーディオアセット管理のスレッドで行う）
+    void LoadSounds();
+    // このフレームの効果音をオーディオスレッドに送る（毎フレーム）
+    void UpdateAudio();
     // サウンドリソースの解放
     void CleanupSound();
     // 効果音の再生
-    void PlaySound(Mix_Chunk* sound);
-    // BGMの再生
-    void PlayMusic(Mix_Music* music, int loops = -1);
+    void PlaySound(AudioAssetManager::Handle sound, int priority = SOUND_PRIORITY_NORMAL);
+    // 位置つきの効果音の再生（ワールド座標、カメラから遠いほど小さく、画面の左右に定位する）
+    void PlaySoundAt(AudioAssetManager::Handle sound, float x, float y, int priority = SOUND_PRIORITY_NORMAL);
+    // BGMの再生（assets/sounds/ からのファイル名、空なら標準のBGM）
+    void PlayMusic(const std::string& file);
+    // 次に使いそうなBGMの先読み
+    void PrefetchMusic(const std::string& file);
+    // BGMのファイル名からオーディオスレッドの曲番号を取得
+    AudioThread::MusicTrack MusicTrackFor(const std::string& file);
     // BGMの停止
     void StopMusic();
     // ボリューム設定
     void SetSoundVolume(int volume);  // 0-128
     void SetMusicVolume(int volume);  // 0-128
-    // サウンドファイルが存在するかチェック
-    bool CheckSoundFile(const std::string& filename);
 #else
     // サウンド無効時のダミーメソッド
     bool InitializeSound() { return true; }
     void CleanupSound() {}
-    void PlaySound(void* sound) {}
+    void PlaySound(void* sound, int priority = 0) {}
+    void PlaySoundAt(void* sound, float x, float y, int priority = 0) {}
 #endif
     
     // === 新機能: UIシステム ===
-    // UIシステムの初期化（フォント読み込み等）
+    // UIシステムの初期化（フォントは fontLoader スレッドで読み込み始める）
     bool InitializeUI();
+    // フォントの読み込み（fontLoader スレッドで実行）
+    void LoadFont();
+    // 最初のフレームの表示後に回した起動処理（コントローラー初期化・起動タイムラインの出力）
+    void FinishStartup();
     // UI描画処理（スコア、ライフ、タイマーを画面に表示）
     void RenderUI();
     // テキストを画面に描画するヘルパー関数
-    void RenderText(const std::string& text, int x, int y, SDL_Color color);
+    void RenderText(const char* text, int x, int y, SDL_Color color);
     // ライフをハートアイコンで描画
     void RenderLives(int x, int y);
     // 時間をMM:SS形式で描画
@@ -534,17 +671,10 @@ private:  // クラス内部でのみアクセス可能なメンバ（プライ
     SDL_GameController* gameController;  // ゲームコントローラー
     bool controllerConnected;            // コントローラー接続状態
     
-    // ボタン状態管理（入力遅延防止）
-    bool prevControllerButtons[SDL_CONTROLLER_BUTTON_MAX];  // 前フレームのボタン状態
-    
     // コントローラー関連メソッド
     void InitializeController();         // コントローラー初期化
-    void HandleControllerInput();        // コントローラー入力処理
     void CleanupController();            // コントローラー終了処理
-    bool GetControllerButton(SDL_GameControllerButton button);  // ボタン状態取得
-    bool GetControllerButtonPressed(SDL_GameControllerButton button);  // ボタン新規押下判定
     float GetControllerAxis(SDL_GameControllerAxis axis);       // スティック軸取得
-    void UpdateControllerButtonStates(); // ボタン状態更新
     
     // === ゲーム状態管理メソッド ===
     void HandleTitleInput();             // タイトル画面の入力処理
@@ -561,6 +691,15 @@ private:  // クラス内部でのみアクセス可能なメンバ（プライ
     void ClampCameraToWorld();           // カメラをワールド範囲内に制限
     int WorldToScreenX(int worldX);      // ワールド座標をスクリーン座標に変換（X軸）
     int WorldToScreenY(int worldY);      // ワールド座標をスクリーン座標に変換（Y軸）
+    
+    // === 描画カリングシステムメソッド ===
+    void RebuildStaticRenderIndex();     // アイテムの空間インデックスを構築（ステージ読み込み時）
+    static void BuildItemIndex(const std::vector<Item>& items, const TileGrid& tiles, SpatialGrid& index);
+    void RebuildDynamicRenderIndex();    // 敵・弾丸・パーティクルの空間インデックスを再構築（更新処理の最後）
+    void BuildVisibleLists();            // カメラ矩形を確定し、可視リストを作成（描画開始時）
+    
+    // === 描画ベンチマーク ===
+    Uint64 ComputeFramebufferChecksum(); // オフスクリーン画像のハッシュ値（FNV-1a）を計算
 
     // === 敵システムメソッド ===
     // 敵システムの初期化
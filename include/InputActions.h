@@ -0,0 +1,38 @@
+#pragma once
+
+#include <SDL.h>
+
+// ゲームの操作（キーボードとコントローラーのどちらからでも同じ操作になる）
+enum InputAction {
+    INPUT_ACTION_LEFT = 0,
+    INPUT_ACTION_RIGHT,
+    INPUT_ACTION_UP,
+    INPUT_ACTION_DOWN,
+    INPUT_ACTION_JUMP,
+    INPUT_ACTION_DASH,
+    INPUT_ACTION_ATTACK,
+    INPUT_ACTION_BEAM,
+    INPUT_ACTION_HEAL,
+    INPUT_ACTION_NEXT_STAGE,
+    INPUT_ACTION_RESTART,
+    INPUT_ACTION_CONFIRM,
+    INPUT_ACTION_PERF_OVERLAY,  // パフォーマンス表示の切り替え（F3）
+    INPUT_ACTION_ANY,           // 何かのキー・ボタン（タイトルの "Press Any Key" 用）
+    INPUT_ACTION_COUNT
+};
+
+// 操作の集合（1操作1ビット）
+typedef Uint32 InputActionBits;
+
+inline InputActionBits ActionBit(InputAction action) {
+    return (InputActionBits)1 << action;
+}
+
+// 1ティック分の操作: ゲームプレイのコードはこれだけを読む（記録・再生もこの単位で行う）
+struct ActionFrame {
+    InputActionBits held;       // 押されている操作
+    InputActionBits pressed;    // このティックで押された操作（ティック内で押して離した場合も含む）
+
+    bool Held(InputAction action) const { return (held & ActionBit(action)) != 0; }
+    bool Pressed(InputAction action) const { return (pressed & ActionBit(action)) != 0; }
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <SDL.h>
+
+#include "InputActions.h"
+
+// 入力バッファ: キーボードとコントローラーのボタンのイベントを SDL のタイムスタンプ付きでリングバッファに記録し、
+// 固定ステップのティックごとに「そのティックの時刻までに起きた入力」だけを順番に取り出して操作（ActionFrame）に変換する
+// - キー・ボタンから操作への割り当てはここだけにあり、ゲームプレイのコードはデバイスを区別しない
+// - 1フレームの間に押して離したキーも、押した記録が残るので取りこぼさない
+// - ジャンプ・ダッシュ・攻撃の押下は一定のティック数（バッファ窓）保持し、実行できた時点で消費する
+//   （着地の少し前にジャンプを押しても、着地したティックでジャンプする）
+class InputBuffer {
+public:
+    // 記録できるイベントの数（ティックで取り出されるまで保持する）
+    static const int CAPACITY = 256;
+    // アクションの押下を保持するティック数の既定値（60ティック/秒で100ms）
+    static const int DEFAULT_BUFFER_TICKS = 6;
+
+    InputBuffer();
+
+    // イベントを記録（HandleEvents から。キーのリピートと関係ないイベントは無視する）
+    void Record(const SDL_Event& event);
+    // ティックの開始: 時刻 time までのイベントを取り出し、このティックの操作を返す
+    // axisActions: スティックから作った方向の操作（アナログ値はイベントではなく毎ティック読む）
+    ActionFrame BeginTick(Uint32 time, InputActionBits axisActions);
+    // このティックの操作を確定し、バッファする操作の押下を積む（再生中は再生した操作を渡す）
+    void BufferActions(const ActionFrame& frame);
+    // すべて離した状態に戻す（記録済みのイベントとアクションも捨てる）
+    void Reset();
+    // バッファされたアクションを捨てる（画面の切り替え時など）
+    void ClearActions();
+    // コントローラーのボタンをすべて離した状態にする（切断時）
+    void ReleaseButtons();
+
+    // バッファされたアクション: 窓の中に未消費の押下があるか・消費する
+    bool HasAction(InputAction action) const { return pendingTicks[action] > 0; }
+    bool ConsumeAction(InputAction action);
+    // アクションの押下を保持するティック数
+    void SetBufferTicks(int ticks) { bufferTicks = ticks; }
+    int BufferTicks() const { return bufferTicks; }
+
+    // リングバッファがあふれて捨てたイベントの数
+    int DroppedEvents() const { return droppedEvents; }
+
+private:
+    // 記録したイベント（キーかボタンの押下・解放）
+    struct InputEvent {
+        Uint32 timestamp;
+        Uint16 code;        // スキャンコードまたはボタン
+        Uint8 isButton;
+        Uint8 down;
+        Uint32 latencyTag;  // 入力遅延の計測用タグ（0=計測しない）
+    };
+
+    InputEvent events[CAPACITY];
+    int head;                   // 最も古いイベントの位置
+    int count;
+    int droppedEvents;
+
+    // キー・ボタンの押下状態
+    Uint8 keys[SDL_NUM_SCANCODES];
+    bool buttons[SDL_CONTROLLER_BUTTON_MAX];
+    // キー・ボタンごとに割り当てた操作
+    InputActionBits keyActions[SDL_NUM_SCANCODES];
+    InputActionBits buttonActions[SDL_CONTROLLER_BUTTON_MAX];
+
+    InputActionBits pressedActions;     // このティックで押された操作
+    InputActionBits previousAxis;       // 前のティックのスティックの操作（押した瞬間の判定用）
+
+    // アクションごとの残りティック（0=押下なし）
+    int pendingTicks[INPUT_ACTION_COUNT];
+    int bufferTicks;
+
+    // 取り出したイベントを押下状態に反映する
+    void Apply(const InputEvent& event);
+    // 押されているキー・ボタンに割り当てた操作
+    InputActionBits HeldActions() const;
+};
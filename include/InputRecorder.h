@@ -0,0 +1,42 @@
+#pragma once
+
+#include <SDL.h>
+#include <string>
+#include <fstream>
+
+#include "InputActions.h"
+
+// 入力の記録・再生: ティックごとの操作（ActionFrame）をファイルに書き出し、同じ順番で読み戻す
+// ゲームプレイは操作だけを読むので、同じ乱数の種から同じ操作を与えれば同じプレイが再現できる
+// ファイル形式: 識別子, バージョン, 乱数の種, 以降ティックごとに held, pressed（どれも Uint32）
+class InputRecorder {
+public:
+    InputRecorder();
+    ~InputRecorder();
+
+    // 記録を開始（seed: このプレイで使う乱数の種）
+    bool StartRecording(const std::string& path, Uint32 seed);
+    // 再生を開始（ファイルに記録された乱数の種を seed に返す）
+    bool StartReplay(const std::string& path, Uint32& seed);
+    // 記録・再生を終了してファイルを閉じる
+    void Stop();
+
+    bool IsRecording() const { return recording; }
+    bool IsReplaying() const { return replaying; }
+
+    // 1ティック分の操作を記録する
+    void Record(const ActionFrame& frame);
+    // 1ティック分の操作を読み出す（記録の終わりに達したら再生を終了して false を返す）
+    bool Replay(ActionFrame& frame);
+
+private:
+    std::ofstream output;
+    std::ifstream input;
+    bool recording;
+    bool replaying;
+    Uint32 tickCount;       // 記録・再生したティック数
+
+    // コピー禁止
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+
+// 入力遅延の計測: キー・ボタンの押下ごとに到着時刻のタグを付け、
+// そのイベントを処理したティック → 描画の開始 → SDL_RenderPresent の呼び出し → 表示の完了 まで追跡して、
+// 押下から表示までの時間の分布を「待ち・シミュレーション・描画・表示待ち」の内訳つきで集計する
+// - 待ち:             到着 → イベントを処理したティック（イベントキューと入力バッファで待った時間）
+// - シミュレーション: ティック → 描画の開始（同じフレームの残りのティックとオーディオ更新を含む）
+// - 描画:             描画の開始 → SDL_RenderPresent の呼び出し
+// - 表示待ち:         SDL_RenderPresent の呼び出し → 戻り（VSync 待ちなど）
+// ゲームスレッドからだけ呼ぶ（無効時は何もしない）
+class LatencyTracker {
+public:
+    // 同時に追跡できる押下の数（これを超えると古いものから捨てる）
+    static const int MAX_IN_FLIGHT = 64;
+
+    // 計測の有効化・無効化
+    static void SetEnabled(bool enable);
+    static bool IsEnabled() { return enabled; }
+
+    // 押下が届いた（timestamp: SDL のイベントのタイムスタンプ）。イベントに付けるタグを返す（0=追跡しない）
+    static Uint32 Arrive(Uint32 timestamp);
+    // タグの付いた押下をティックで処理した
+    static void Consume(Uint32 tag);
+    // 描画の開始・SDL_RenderPresent の前後
+    static void BeginRender();
+    static void BeginPresent();
+    static void EndPresent();
+
+    // 集計結果をコンソールに出力
+    static void PrintReport();
+
+private:
+    // 追跡中の押下（時刻はパフォーマンスカウンタ、0=まだその段階に達していない）
+    struct Sample {
+        Uint32 tag;             // 0=空き
+        Uint64 arrival;
+        Uint64 consumed;
+        Uint64 renderStart;
+        Uint64 presentStart;
+    };
+
+    static bool enabled;
+    static Uint32 nextTag;
+    static Sample inFlight[MAX_IN_FLIGHT];
+    static int droppedSamples;              // 表示まで追跡できずに捨てた押下の数
+
+    // 表示まで追跡できた押下の内訳（ミリ秒）
+    static std::vector<double> queueTimes;
+    static std::vector<double> simulationTimes;
+    static std::vector<double> renderTimes;
+    static std::vector<double> presentTimes;
+    static std::vector<double> totalTimes;
+
+    static double ToMilliseconds(Uint64 ticks);
+    // 1つの内訳の分布を出力
+    static void PrintDistribution(const char* name, std::vector<double> values);
+};
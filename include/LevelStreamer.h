@@ -0,0 +1,87 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+#include <map>
+#include <set>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "TileGrid.h"
+#include "ChunkSource.h"
+#include "Enemy.h"
+#include "Item.h"
+
+// レベルストリーマー: 横長のステージを固定幅のチャンク単位で読み込み、
+// カメラ周辺のチャンク（ウィンドウ）だけをメモリに常駐させる
+// 進行方向の先のチャンクはバックグラウンドスレッドで先読みし、
+// 後方に離れたチャンクは敵・アイテムの状態を保存してから破棄する
+class LevelStreamer {
+public:
+    // 常駐させるチャンク数（後方1 + 画面 + 前方）
+    static const int WINDOW_CHUNKS = 4;
+
+    // コンストラクタ: 読み込み元を指定（所有権を受け取る）
+    LevelStreamer(ChunkSource* source);
+    // デストラクタ: 読み込みスレッドを停止し、チャンクを解放
+    ~LevelStreamer();
+
+    // ステージ情報を読み込み、読み込みスレッドを起動する
+    bool Open();
+    // ステージ全体の情報
+    const LevelInfo& GetInfo() const { return info; }
+
+    // カメラの表示範囲（ワールド座標）に合わせてウィンドウを更新する
+    // ウィンドウが変わった場合は map を作り直し、敵・アイテムを入れ替えて true を返す
+    bool Update(const SDL_Rect& view, TileGrid& map, std::vector<Enemy>& enemies, std::vector<Item>& items);
+
+    // 統計（読み込みが間に合わず同期読み込みした回数など）
+    int GetFirstChunk() const { return firstChunk; }
+    int GetSyncLoadCount() const { return syncLoads; }
+
+private:
+    // 破棄したチャンクに保存しておく敵・アイテムの状態
+    struct SavedChunkState {
+        std::vector<Enemy> enemies;
+        std::vector<Item> items;
+    };
+
+    ChunkSource* source;
+    LevelInfo info;
+    int chunkPixelWidth;                        // 1チャンクの幅（ピクセル）
+
+    // 常駐中のチャンク（firstChunk から順に最大 WINDOW_CHUNKS 個）
+    std::vector<LevelChunk*> resident;
+    int firstChunk;                             // ウィンドウ先頭のチャンク番号（未読み込みなら-1）
+    int lastViewX;                              // 前回のカメラ位置（進行方向の判定用）
+    int travelDirection;                        // 進行方向（1=右, -1=左）
+    int syncLoads;                              // 同期読み込みの回数
+
+    std::map<int, SavedChunkState> savedStates; // 破棄したチャンクの状態
+    std::set<int> spawnedChunks;                // 初期配置を生成済みのチャンク
+
+    // 読み込みスレッド
+    std::thread loader;
+    std::mutex mutex;
+    std::condition_variable requestCondition;
+    std::deque<int> requests;                   // 読み込み要求（チャンク番号）
+    std::map<int, LevelChunk*> ready;           // 先読み済みのチャンク
+    std::set<int> pending;                      // 要求中・読み込み中のチャンク
+    bool stopping;
+
+    // 読み込みスレッドのメインループ
+    void LoaderLoop();
+    // 先読みを要求（読み込み済み・要求済みなら何もしない）
+    void RequestChunk(int index);
+    // 先読み済みのチャンクを取り出す（間に合っていなければこのスレッドで読み込む）
+    LevelChunk* AcquireChunk(int index);
+    // ウィンドウから遠い先読み済みチャンクを破棄
+    void PruneReady();
+
+    // 表示範囲に対して望ましいウィンドウ先頭を計算
+    int ChooseFirstChunk(const SDL_Rect& view) const;
+    // X座標からチャンク番号を求める
+    int ChunkAt(int worldX) const;
+};
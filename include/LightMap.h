@@ -0,0 +1,45 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+
+// 2Dライトマップ: 画面の1/scale解像度のバッファに光源を加算し、
+// 1枚のテクスチャとしてシーンに乗算合成する（光源数に関係なく描画呼び出しは1回）
+class LightMap {
+public:
+    // コンストラクタ: 画面サイズと縮小率（4なら1/4解像度）を指定
+    LightMap(int screenWidth, int screenHeight, int scale);
+    // デストラクタ: テクスチャを解放
+    ~LightMap();
+
+    // フレームの開始: 環境光（0.0=真っ暗, 1.0=そのまま）で初期化し、遮蔽情報をクリア
+    void Begin(float ambientLevel);
+    // 光を遮るブロックを登録（スクリーン座標の矩形、光源より先に登録する）
+    void AddOccluder(const SDL_Rect& screenRect);
+    // 点光源を加算（スクリーン座標の中心・半径、色、強さ）
+    void AddLight(int screenX, int screenY, int radius, SDL_Color color, float intensity);
+    // ライトマップをテクスチャに転送し、画面全体に乗算合成する
+    void Render(SDL_Renderer* renderer);
+
+    // 今フレームに加算した光源の数
+    int GetLightCount() const { return lightCount; }
+
+private:
+    int screenWidth, screenHeight;  // 画面サイズ
+    int scale;                      // 縮小率
+    int width, height;              // ライトマップの解像度
+    float ambient;                  // 環境光の明るさ（0-255）
+    int lightCount;                 // 今フレームの光源数
+
+    // 光の蓄積バッファ（SIMDで扱いやすいようにRGBを別々の配列で保持）
+    std::vector<float> red, green, blue;
+    // 遮蔽マスク（1=ブロック内部）
+    std::vector<Uint8> occlusion;
+
+    // ストリーミングテクスチャ
+    SDL_Texture* texture;
+    SDL_Renderer* textureRenderer;  // テクスチャを作成したレンダラー
+
+    // テクスチャの作成（レンダラーが変わった場合は作り直す）
+    bool EnsureTexture(SDL_Renderer* renderer);
+};
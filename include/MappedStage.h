@@ -0,0 +1,48 @@
+#pragma once
+
+#include <SDL.h>
+#include <string>
+
+#include "StageFormat.h"
+
+// メモリマップしたステージファイル: 読み込み時はヘッダと各セクションの範囲を検証するだけで、
+// タイルや配置データは解析せずにファイルの内容を直接参照する
+class MappedStage {
+public:
+    MappedStage();
+    // デストラクタ: マップを解除
+    ~MappedStage();
+
+    // ファイルをメモリにマップして検証する
+    bool Open(const std::string& path);
+    // マップを解除
+    void Close();
+
+    // マップしたファイルのパス
+    const std::string& Path() const { return path; }
+    // ヘッダ（Open成功後のみ有効）
+    const StageFileHeader& Header() const { return *(const StageFileHeader*)data; }
+    // タイル層（width * height バイト、行優先）
+    const Uint8* Tiles() const { return data + Header().tilesOffset; }
+    // 敵・アイテムの配置
+    const StageFileSpawn* Enemies() const { return (const StageFileSpawn*)(data + Header().enemiesOffset); }
+    const StageFileSpawn* Items() const { return (const StageFileSpawn*)(data + Header().itemsOffset); }
+    int EnemyCount() const { return (int)Header().enemyCount; }
+    int ItemCount() const { return (int)Header().itemCount; }
+    // ステージ名・BGMファイル名
+    std::string Name() const { return std::string((const char*)data + Header().nameOffset, Header().nameLength); }
+    std::string Bgm() const { return std::string((const char*)data + Header().bgmOffset, Header().bgmLength); }
+
+private:
+    std::string path;           // ファイルのパス
+    const Uint8* data;          // ファイルの先頭
+    size_t size;                // ファイルのバイト数
+    bool mapped;                // mmapで確保したか（falseなら読み込んだバッファ）
+
+    // コピー禁止（マップの二重解除を防ぐ）
+    MappedStage(const MappedStage&) = delete;
+    MappedStage& operator=(const MappedStage&) = delete;
+
+    // ヘッダと各セクションの範囲を検証
+    bool Validate() const;
+};
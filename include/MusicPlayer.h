@@ -0,0 +1,90 @@
+#pragma once
+
+// SDL_mixerが利用可能な場合のみ使用する
+#ifdef SOUND_ENABLED
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "MusicStream.h"
+
+// BGMプレイヤー: ステージごとの曲をファイルから少しずつ読みながら再生する
+// ファイルを開く・先読みする・曲を切り替える処理はすべてBGMスレッドで行い、ゲームスレッドは要求を置くだけ
+// SDL_mixer の音楽チャンネルは1つなので、切り替えは前の曲のフェードアウト→次の曲のフェードインで行う
+// 音楽チャンネルの関数（Mix_*Music）はすべてBGMスレッドから呼ぶ（音量の変更も要求として渡す）
+class MusicPlayer {
+public:
+    // 曲の切り替え・停止のフェード時間（ミリ秒）
+    static const int FADE_MS = 800;
+    // 先読みの間隔（ミリ秒）
+    static const int FILL_INTERVAL_MS = 10;
+
+    // コンストラクタ: BGMスレッドを起動（Mix_OpenAudio の後に作る）
+    MusicPlayer();
+    // デストラクタ: 再生を止めてBGMスレッドを終了し、開いている曲をすべて閉じる
+    ~MusicPlayer();
+
+    // 曲を切り替える（同じ曲が再生中・切り替え中なら何もしない）
+    // path が開けなければ fallbackPath を試す
+    void Play(const std::string& path, const std::string& fallbackPath = "");
+    // 次に使いそうな曲を開いて最初の窓を読み込んでおく（1曲だけ保持する）
+    void Prefetch(const std::string& path, const std::string& fallbackPath = "");
+    // フェードアウトして止める
+    void Stop();
+    // BGMの音量を変える（0～MIX_MAX_VOLUME）
+    void SetVolume(int volume);
+
+private:
+    // 開いた曲（ストリームとデコーダ）
+    // 同じ曲かどうかは実際に開いたファイルではなく、要求されたパスの組で判定する
+    struct Track {
+        MusicStream* stream;
+        Mix_Music* music;
+        std::string path;           // 要求されたパス
+        std::string fallbackPath;   // path が開けなかった時に試したパス
+
+        bool Matches(const std::string& otherPath, const std::string& otherFallbackPath) const {
+            return path == otherPath && fallbackPath == otherFallbackPath;
+        }
+    };
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable condition;
+    // ゲームスレッドからの要求（mutex で保護）
+    bool stopping;
+    bool stopRequested;
+    std::string playPath;
+    std::string playFallbackPath;
+    std::string prefetchPath;
+    std::string prefetchFallbackPath;
+    int volumeRequest;      // 変更する音量（-1=要求なし）
+
+    // 以下はBGMスレッドだけが触る
+    Track* current;         // 再生中（またはフェードアウト中）の曲
+    Track* next;            // フェードアウトが終わったら始める曲
+    Track* prefetched;      // 先読みしておいた曲
+    bool fadingOut;
+
+    // BGMスレッドのメインループ
+    void WorkerLoop();
+    // 要求された曲に切り替える
+    void SwitchTo(const std::string& path, const std::string& fallbackPath);
+    // 曲を開く（先読み済みならそれを使う、path が開けなければ fallbackPath を試す）
+    Track* OpenTrack(const std::string& path, const std::string& fallbackPath);
+    // ファイルを1つ開いてデコーダを作る
+    Track* OpenFile(const std::string& file);
+    void CloseTrack(Track*& track);
+    // 曲の切り替え先として最後に決まっている曲
+    const Track* TargetTrack() const;
+
+    // コピー禁止
+    MusicPlayer(const MusicPlayer&) = delete;
+    MusicPlayer& operator=(const MusicPlayer&) = delete;
+};
+
+#endif  // SOUND_ENABLED
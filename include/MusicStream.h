@@ -0,0 +1,74 @@
+#pragma once
+
+// SDL_mixerが利用可能な場合のみ使用する
+#ifdef SOUND_ENABLED
+
+#include <SDL.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <mutex>
+
+// BGM用の先読みストリーム: 圧縮されたままの曲ファイルのうち、再生位置の前後の小さな窓だけをメモリに置く
+// 窓はBGMスレッドが Fill() で先読みし、デコーダ（SDL_mixer）は SDL_RWops 経由で窓から読む
+// 窓の外へのシーク（ループ時の先頭への巻き戻しなど）は、その位置から窓を作り直す
+class MusicStream {
+public:
+    // メモリに置く窓の大きさ（バイト）
+    static const int WINDOW_SIZE = 64 * 1024;
+    // 窓を前に詰める時に残す、再生位置より前のデータ（短い巻き戻し用）
+    static const int HISTORY_SIZE = 4 * 1024;
+
+    MusicStream();
+    // デストラクタ: ファイルと SDL_RWops を閉じる（先にこのストリームの Mix_Music を解放すること）
+    ~MusicStream();
+
+    // ファイルを開いて最初の窓を読み込む
+    bool Open(const std::string& path);
+    const std::string& Path() const { return path; }
+    // デコーダ用の読み込み口（ストリームが所有する）
+    SDL_RWops* RWops() const { return rw; }
+
+    // 先読み: 再生位置より先のデータが窓の半分を切っていたら補充する（BGMスレッドから呼ぶ）
+    void Fill();
+    // 先読みが間に合わずデコーダ側で直接読んだ回数
+    int Underruns();
+
+private:
+    std::string path;
+    FILE* file;
+    Sint64 fileSize;
+    Sint64 filePosition;            // ファイルの現在位置
+    SDL_RWops* rw;
+
+    std::mutex mutex;               // BGMスレッドとデコーダ（オーディオスレッド）の排他（窓と読み込み位置）
+    std::mutex fileMutex;           // ファイルの読み込みの排他（mutex を持ったまま取るのはデコーダ側だけ）
+    std::vector<Uint8> window;      // 先読みした窓
+    std::vector<Uint8> scratch;     // 先読みでファイルから読んだデータ（mutex の外で読む）
+    Sint64 windowStart;             // 窓の先頭のファイル内位置
+    size_t windowFill;              // 窓に入っているバイト数
+    Sint64 readPosition;            // デコーダの読み込み位置
+    int underruns;
+
+    // 再生位置に合わせて窓を詰めて、ファイルの続きを読み込む（mutex を持って呼ぶ）
+    void FillLocked();
+    // 読み終わった部分を前に詰める・窓の外にシークしていたら窓を作り直す（mutex を持って呼ぶ）
+    void CompactLocked();
+    // ファイルの offset から最大 bytes バイトを読む（fileMutex を持って呼ぶ）
+    size_t ReadFile(Sint64 offset, Uint8* destination, size_t bytes);
+    size_t Read(void* destination, size_t bytes);
+    Sint64 Seek(Sint64 offset, int whence);
+
+    // SDL_RWops のコールバック
+    static Sint64 SizeCallback(SDL_RWops* context);
+    static Sint64 SeekCallback(SDL_RWops* context, Sint64 offset, int whence);
+    static size_t ReadCallback(SDL_RWops* context, void* pointer, size_t size, size_t count);
+    static size_t WriteCallback(SDL_RWops* context, const void* pointer, size_t size, size_t count);
+    static int CloseCallback(SDL_RWops* context);
+
+    // コピー禁止
+    MusicStream(const MusicStream&) = delete;
+    MusicStream& operator=(const MusicStream&) = delete;
+};
+
+#endif  // SOUND_ENABLED
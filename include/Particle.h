@@ -33,8 +33,8 @@ public:
     // 更新処理
     void Update();
     
-    // 描画処理
-    void Render(SDL_Renderer* renderer);
+    // 描画処理（cameraX, cameraY: ワールド座標からスクリーン座標へのカメラオフセット）
+    void Render(SDL_Renderer* renderer, int cameraX, int cameraY);
     
     // 生存判定
     bool IsAlive();
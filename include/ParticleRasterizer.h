@@ -0,0 +1,70 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#include "Particle.h"
+
+// CPUパーティクルラスタライザ: 大量のパーティクルを画面サイズのRGBAバッファにCPUで描き込み、
+// ストリーミングテクスチャ1枚として転送する（描画呼び出しはフレームあたり1回）
+// 画面を水平の帯に分割し、ワーカースレッドが帯ごとに並列でブレンドする
+class ParticleRasterizer {
+public:
+    // コンストラクタ: 描画先の幅・高さ（スクリーン座標）を指定
+    ParticleRasterizer(int width, int height);
+    // デストラクタ: ワーカースレッドを停止し、テクスチャを解放
+    ~ParticleRasterizer();
+
+    // 可視パーティクルをラスタライズして画面に合成する
+    // particles: パーティクル配列, visible: 描画するインデックス, cameraX/Y: カメラオフセット
+    // 戻り値: 描画できた場合true（テクスチャ作成に失敗した場合は呼び出し側で通常描画する）
+    bool Render(SDL_Renderer* renderer, const std::vector<Particle>& particles,
+                const std::vector<int>& visible, int cameraX, int cameraY);
+
+private:
+    // 1パーティクル分の描画情報（スクリーン座標でクリップ済みの正方形）
+    struct Splat {
+        int x0, y0, x1, y1;   // 描画範囲（x1, y1は含まない）
+        Uint32 color;         // 乗算済みアルファのARGB色
+        Uint32 alpha;         // アルファ値（0-255）
+    };
+
+    int width, height;                          // バッファサイズ
+    std::vector<Uint32> buffer;                 // 乗算済みアルファのARGBバッファ
+    std::vector<Splat> splats;                  // 今フレームの描画情報
+    std::vector<std::vector<int>> bandSplats;   // 帯ごとに振り分けた描画情報のインデックス
+    int bandCount;                              // 帯の数
+    int bandHeight;                             // 1帯の行数
+
+    // ストリーミングテクスチャ
+    SDL_Texture* texture;
+    SDL_Renderer* textureRenderer;              // テクスチャを作成したレンダラー
+    bool premultipliedBlend;                    // 乗算済みアルファ用ブレンドモードが使えるか
+    Uint8* lockedPixels;                        // ロック中のテクスチャメモリ
+    int lockedPitch;                            // ロック中のテクスチャの1行のバイト数
+
+    // ワーカースレッド
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable startCondition;     // 仕事の開始通知
+    std::condition_variable doneCondition;      // 全帯の完了通知
+    int generation;                             // 仕事の世代番号（開始通知の判定用）
+    bool stopping;                              // 終了要求
+    std::atomic<int> nextBand;                  // 次に処理する帯
+    std::atomic<int> remainingBands;            // 未完了の帯の数
+
+    // テクスチャの作成（レンダラーが変わった場合は作り直す）
+    bool EnsureTexture(SDL_Renderer* renderer);
+    // 全帯をワーカーと分担して処理（呼び出し元スレッドも参加する）
+    void RunBands();
+    // 処理待ちの帯を取り出して処理する
+    void ProcessBands();
+    // 1つの帯をクリア・ブレンドし、ロック中のテクスチャへ書き出す
+    void RasterizeBand(int band);
+    // ワーカースレッドのメインループ
+    void WorkerLoop();
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+
+#include "AllocationTracker.h"
+
+// 描画プロファイラ: 描画呼び出し回数・ステート変更回数・ゾーンごとの時間を集計する
+// 描画はこのクラスのラッパー関数を経由して行う（無効時は集計せずSDLにそのまま転送する）
+class RenderProfiler {
+public:
+    // ゾーンごとの集計結果
+    struct ZoneStats {
+        const char* name;      // ゾーン名
+        Uint64 ticks;          // 累計時間（パフォーマンスカウンタ単位、内側のゾーンを含む）
+        int entries;           // ゾーンに入った回数
+        int drawCalls;         // このゾーン直下での描画呼び出し回数
+        int stateChanges;      // このゾーン直下でのステート変更回数
+    };
+
+    // 集計の有効化・無効化
+    static void SetEnabled(bool enable);
+    static bool IsEnabled() { return enabled; }
+
+    // 集計結果をすべてクリア
+    static void Reset();
+    // 1フレーム分の描画が終わったことを通知
+    static void EndFrame();
+    // 集計結果をコンソールに出力
+    static void PrintReport();
+
+    // 計測ゾーンの開始・終了（入れ子可）
+    static void BeginZone(const char* name);
+    static void EndZone();
+
+    // === 描画ラッパー（SDLの同名関数に対応） ===
+    static int SetDrawColor(SDL_Renderer* renderer, Uint8 r, Uint8 g, Uint8 b, Uint8 a);
+    static int SetDrawBlendMode(SDL_Renderer* renderer, SDL_BlendMode blendMode);
+    static int Clear(SDL_Renderer* renderer);
+    static int FillRect(SDL_Renderer* renderer, const SDL_Rect* rect);
+    static int DrawRect(SDL_Renderer* renderer, const SDL_Rect* rect);
+    static int DrawLine(SDL_Renderer* renderer, int x1, int y1, int x2, int y2);
+    static int DrawPoint(SDL_Renderer* renderer, int x, int y);
+    static int Copy(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect* dstRect);
+    static SDL_Texture* CreateTextureFromSurface(SDL_Renderer* renderer, SDL_Surface* surface);
+
+private:
+    static bool enabled;                    // 集計中かどうか
+    static int frames;                      // 集計したフレーム数
+    static int drawCalls;                   // 描画呼び出しの総数
+    static int stateChanges;                // ステート変更の総数
+    static int redundantStateChanges;       // 直前と同じ値を設定したステート変更の数
+    static int textureUploads;              // サーフェスからのテクスチャ作成回数
+    static std::vector<ZoneStats> zones;    // ゾーンの集計（登録順）
+    static std::vector<int> zoneStack;      // 計測中のゾーン（インデックス）
+    static std::vector<Uint64> zoneStarts;  // 計測中ゾーンの開始時刻
+
+    // 直前に設定したステート（冗長な変更の検出用）
+    static bool hasLastColor;
+    static SDL_Color lastColor;
+    static bool hasLastBlendMode;
+    static SDL_BlendMode lastBlendMode;
+
+    // 描画呼び出し・ステート変更を現在のゾーンに記録
+    static void CountDrawCall();
+    static void CountStateChange(bool redundant);
+};
+
+// スコープの間を1つの描画ゾーンとして計測するヘルパー（ヒープ確保もゾーンごとに数える）
+class RenderZone {
+public:
+    RenderZone(const char* name) : allocationZone(name) { RenderProfiler::BeginZone(name); }
+    ~RenderZone() { RenderProfiler::EndZone(); }
+
+private:
+    AllocationZone allocationZone;
+};
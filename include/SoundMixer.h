@@ -0,0 +1,90 @@
+#pragma once
+
+// SDL_mixerが利用可能な場合のみ使用する
+#ifdef SOUND_ENABLED
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <vector>
+
+#include "AudioAssetManager.h"
+
+// 効果音の優先度（ボイスが足りない場合は低いものから諦める）
+enum SoundPriority {
+    SOUND_PRIORITY_LOW = 0,     // 大量に鳴る音（敵の撃破など）
+    SOUND_PRIORITY_NORMAL = 1,  // 通常の音（ジャンプ・アイテムなど）
+    SOUND_PRIORITY_HIGH = 2     // 必ず聞かせたい音（ダメージなど）
+};
+
+// 効果音ミキサー: 1フレーム分の再生要求を集め、フレームの最後にまとめて鳴らす
+// 位置つきの要求はリスナー（カメラの中心）からの距離で減衰・左右に定位させ、聞こえないものはここで捨てる
+// 同じ音の重複は1つのボイスにまとめて音量を上げ、音ごと・全体のボイス数を上限で抑える
+// （大勢の敵を一度に倒しても Mix_PlayChannel の回数とチャンネルの奪い合いが増えない）
+class SoundMixer {
+public:
+    // 使用するチャンネル数（全体のボイス上限）
+    static const int MAX_VOICES = 12;
+    // 同じ音を同時に鳴らせる数
+    static const int MAX_VOICES_PER_SOUND = 3;
+    // この時間内に同じ音を鳴らした場合は新しいボイスを作らず前のボイスを大きくする（ミリ秒）
+    static const Uint32 COALESCE_WINDOW_MS = 60;
+    // 位置つき効果音の距離減衰（ピクセル）: この距離までは最大音量、MAX で無音
+    static const int FULL_VOLUME_DISTANCE = 400;
+    static const int MAX_AUDIBLE_DISTANCE = 1200;
+    // 左右に完全に振り切る横方向の距離（ピクセル）
+    static const int PAN_DISTANCE = 600;
+    // これより小さい音量（0-1）の要求は鳴らさない
+    static constexpr float MIN_AUDIBLE_GAIN = 0.05f;
+
+    // コンストラクタ: チャンネルを確保（Mix_OpenAudio の後に作る）
+    SoundMixer(AudioAssetManager* assets);
+
+    // 再生を要求（実際に鳴るのは Flush 時）
+    void Post(AudioAssetManager::Handle sound, int priority);
+    // 位置つきの再生を要求（ワールド座標）
+    void PostAt(AudioAssetManager::Handle sound, int priority, float x, float y);
+    // リスナーの位置（ワールド座標、通常はカメラの中心）
+    void SetListener(float x, float y);
+    // 集めた要求をまとめて鳴らす（1フレームに1回）
+    void Flush(Uint32 now);
+    // 基本の音量（0-128）
+    void SetVolume(int volume);
+    // すべてのボイスを止める
+    void StopAll();
+
+private:
+    // 再生要求
+    struct Request {
+        AudioAssetManager::Handle sound;
+        int priority;
+        int count;      // まとめた要求の数
+        bool positional;
+        float x, y;     // ワールド座標（位置つきの場合）
+        float gain;     // 距離による音量（0-1）
+        float pan;      // 左右の定位（-1=左, 0=中央, 1=右）
+    };
+    // チャンネルごとのボイスの状態
+    struct Voice {
+        AudioAssetManager::Handle sound;
+        int priority;
+        Uint32 startTime;
+        int count;      // このボイスにまとめた要求の数
+        float gain;
+    };
+
+    AudioAssetManager* assets;
+    int baseVolume;
+    float listenerX, listenerY;
+    std::vector<Request> requests;      // 今フレームの要求
+    std::vector<Request> merged;        // 聞こえる要求を音ごとに1つにまとめたもの
+    Voice voices[MAX_VOICES];
+
+    // 位置つきの要求の音量と定位をまとめて計算し、聞こえない要求を捨てて音ごとにまとめる
+    void Spatialize();
+    // まとめた数と距離に応じた音量（重なるほど大きく、上限は MIX_MAX_VOLUME）
+    int CoalescedVolume(int count, float gain) const;
+    // 要求を1つ鳴らす（既存ボイスの強調・空きチャンネル・横取りの順に試す）
+    void Play(const Request& request, Uint32 now);
+};
+
+#endif  // SOUND_ENABLED
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+
+// 描画レイヤーの種類（可視リストはレイヤーごとに分けて保持する）
+enum RenderLayer {
+    LAYER_ENEMY = 0,             // 敵キャラクター
+    LAYER_ITEM = 1,              // アイテム
+    LAYER_ENEMY_PROJECTILE = 2,  // 敵の弾丸
+    LAYER_BOSS_PROJECTILE = 3,   // ボスの弾丸
+    LAYER_PARTICLE = 4,          // パーティクル
+    LAYER_COUNT = 5              // レイヤー数
+};
+
+// 1フレーム分の可視リスト: 各レイヤーの配列インデックスを詰めて保持する
+struct VisibleLists {
+    std::vector<int> indices[LAYER_COUNT];
+
+    // 全レイヤーを空にする（確保済みの容量は再利用する）
+    void Clear();
+};
+
+// 空間インデックス: ワールドを一定サイズのセルに分割し、矩形での問い合わせ対象を絞り込む
+// 各エントリは左上が含まれるセルに1回だけ登録し、問い合わせ側で最大サイズ分だけ範囲を広げる
+// エントリは全セル共通の配列に置き、セルごとに登録順の連結リストでたどる
+// （毎フレーム作り直しても、配列が最大数まで伸びた後はヒープ確保をしない）
+class SpatialGrid {
+public:
+    // コンストラクタ: セルの一辺の長さ（ピクセル）を指定
+    SpatialGrid(int cellSize);
+
+    // 対象領域（ワールド座標）に合わせてセルを確保し直し、中身を空にする
+    void Reset(const SDL_Rect& region);
+
+    // 登録済みのエントリをすべて削除（セル配列と容量は保持）
+    void Clear();
+
+    // エントリの配列をあらかじめ確保しておく
+    void Reserve(int entryCount) { entries.reserve(entryCount); }
+
+    // エントリを登録（layer: 描画レイヤー, index: 元配列のインデックス, bounds: ワールド座標の矩形）
+    void Insert(RenderLayer layer, int index, const SDL_Rect& bounds);
+
+    // 矩形と重なるエントリをレイヤー別に out へ追加する
+    void Query(const SDL_Rect& area, VisibleLists& out) const;
+
+private:
+    // セルに格納するエントリ
+    struct Entry {
+        SDL_Rect bounds;   // ワールド座標の矩形
+        int index;         // 元配列のインデックス
+        RenderLayer layer; // 描画レイヤー
+        int next;          // 同じセルの次のエントリ（-1=最後）
+    };
+    // セルごとの連結リストの先頭と末尾（-1=空）
+    struct Cell {
+        int first;
+        int last;
+    };
+
+    int cellSize;                         // セルの一辺（ピクセル）
+    SDL_Rect region;                      // インデックスが覆うワールド領域
+    int columns, rows;                    // セルの列数・行数
+    int maxEntryWidth, maxEntryHeight;    // 登録済みエントリの最大サイズ（問い合わせ範囲の拡張用）
+    std::vector<Cell> cells;              // セルごとの連結リスト
+    std::vector<Entry> entries;           // 登録済みのエントリ（全セル共通）
+
+    // ワールド座標をセル座標に変換（領域外は端のセルに丸める）
+    int CellColumn(int worldX) const;
+    int CellRow(int worldY) const;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <SDL.h>
+
+#include "Goal.h"
+#include "MappedStage.h"
+#include "StageFormat.h"
+
+// ステージデータ構造体
+struct StageData {
+    int stageNumber;                                    // ステージ番号
+    std::string stageName;                              // ステージ名
+    GoalType goalType;                                  // ゴールの種類
+    int goalX, goalY;                                   // ゴール位置
+    int playerStartX, playerStartY;                     // プレイヤー開始位置
+    int timeLimit;                                      // 制限時間（秒、0=無制限）
+    std::string bgmFile;                                // BGMファイル名
+    std::string streamDirectory;                        // チャンクファイルのディレクトリ（空でなければストリーミング）
+    bool generated;                                     // 手続き生成のステージか（ストリーミングで生成する）
+    Uint32 generatorSeed;                               // 手続き生成のシード値
+    
+    // タイル層と配置表（組み込みステージの静的テーブル、またはマップしたステージファイルを指す）
+    int width, height;                                  // タイル単位のサイズ（サイズはステージごとに可変）
+    const Uint8* tiles;                                 // タイル層（1タイル1バイト、行優先）
+    const StageFileSpawn* enemySpawns;                  // 敵の配置（種類を含む）
+    int enemyCount;
+    const StageFileSpawn* itemSpawns;                   // アイテムの配置
+    int itemCount;
+    std::shared_ptr<MappedStage> stageFile;             // 参照先のステージファイル（組み込みステージではnullptr）
+    
+    // コンストラクタ
+    StageData() : stageNumber(1), stageName("Stage 1"), goalType(GOAL_FLAG), 
+                  goalX(0), goalY(0), playerStartX(100), playerStartY(300), 
+                  timeLimit(0), bgmFile(""), generated(false), generatorSeed(0),
+                  width(0), height(0), tiles(nullptr),
+                  enemySpawns(nullptr), enemyCount(0), itemSpawns(nullptr), itemCount(0) {
+    }
+    
+    // チャンク単位で読み込むステージか（ファイルからのストリーミングまたは手続き生成）
+    bool IsStreamed() const { return generated || !streamDirectory.empty(); }
+};
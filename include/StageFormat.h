@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+// ステージファイル（.stg）の形式定義
+// ゲーム本体とステージコンパイラ（tools/stagec.cpp）で共有する
+//
+// [StageFileHeader][タイル width*height バイト][敵の配置][アイテムの配置][ステージ名][BGMファイル名]
+// 各セクションは4バイト境界に揃え、位置はファイル先頭からのオフセットで表す
+// 数値はリトルエンディアン。読み込み側はファイルをメモリにマップしてそのまま参照する
+
+// ファイルの識別子とバージョン（形式を変えたらバージョンを上げる）
+const uint32_t STAGE_FILE_MAGIC = 0x31475453;  // "STG1"
+const uint32_t STAGE_FILE_VERSION = 1;
+
+// ファイルヘッダ
+struct StageFileHeader {
+    uint32_t magic;             // STAGE_FILE_MAGIC
+    uint32_t version;           // STAGE_FILE_VERSION
+    uint32_t fileSize;          // ファイル全体のバイト数
+    int32_t stageNumber;        // ステージ番号
+    int32_t width, height;      // タイル単位のサイズ
+    int32_t playerStartX;       // プレイヤー開始位置
+    int32_t playerStartY;
+    int32_t goalType;           // GoalType
+    int32_t goalX, goalY;       // ゴール位置
+    int32_t timeLimit;          // 制限時間（秒、0=無制限）
+    uint32_t tilesOffset;       // タイル層（1タイル1バイト、行優先）
+    uint32_t enemyCount;        // 敵の数
+    uint32_t enemiesOffset;     // 敵の配置（StageFileSpawn の配列）
+    uint32_t itemCount;         // アイテムの数
+    uint32_t itemsOffset;       // アイテムの配置（StageFileSpawn の配列）
+    uint32_t nameOffset;        // ステージ名（UTF-8、終端なし）
+    uint32_t nameLength;
+    uint32_t bgmOffset;         // BGMファイル名（UTF-8、終端なし）
+    uint32_t bgmLength;
+};
+
+// 敵・アイテムの配置（ワールド座標のピクセル位置と種類）
+struct StageFileSpawn {
+    int32_t x, y;
+    int32_t type;               // EnemyType または ItemType
+};
+
+// セクションの先頭を4バイト境界に揃える
+inline uint32_t AlignStageOffset(uint32_t offset) {
+    return (offset + 3u) & ~3u;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+
+#include "ChunkSource.h"
+
+// プレイヤーの移動能力（タイル単位）: 生成する地形はこの範囲で必ず通り抜けられるようにする
+struct PlayerReach {
+    int jumpHeight;     // ジャンプで登れる段差（行数）
+    int gapWidth;       // 飛び越えられる穴の幅（列数、ダッシュ込み）
+    int climbHeight;    // 壁登りで登れる壁の高さ（行数、0=壁登りなし）
+};
+
+// 手続き型ステージ生成: シード値からチャンク単位で地形・敵・アイテムを決定的に生成する
+// ChunkSource として LevelStreamer に渡すと、読み込みスレッドでプレイヤーの先のチャンクが生成される
+// チャンクはシード値と番号だけで決まるため、どの順番で生成しても同じ地形になる
+class StageGenerator : public ChunkSource {
+public:
+    static const int CHUNK_WIDTH = 32;          // 1チャンクの幅（タイル単位）
+    static const int STAGE_HEIGHT = 19;         // ステージの高さ（タイル単位）
+    static const int CHUNK_COUNT = 1 << 20;     // チャンク数（ワールド座標がintに収まる範囲で事実上無限）
+
+    // コンストラクタ: シード値とプレイヤーの移動能力を指定
+    StageGenerator(Uint32 seed, const PlayerReach& reach);
+
+    bool ReadInfo(LevelInfo& info) override;
+    bool LoadChunk(int index, LevelChunk& chunk) override;
+
+    // チャンクの左端（entryGround の地面）から右端（exitGround の地面）まで到達できるか
+    // tiles は CHUNK_WIDTH x STAGE_HEIGHT、地面の高さは最上段のブロックの行
+    bool IsReachable(const std::vector<Uint8>& tiles, int entryGround, int exitGround) const;
+
+private:
+    Uint32 seed;
+    PlayerReach reach;
+
+    // チャンク境界（boundary 番目のチャンクの左端）の地面の高さ
+    int BoundaryGround(int boundary) const;
+};
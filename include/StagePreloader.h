@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "StageData.h"
+#include "TileGrid.h"
+#include "Enemy.h"
+#include "Item.h"
+#include "Goal.h"
+#include "SpatialGrid.h"
+
+// 読み込み済みのステージの実行時状態（ゲーム側の状態と丸ごと入れ替える）
+struct PreparedStage {
+    int stageIndex;                 // ステージ番号（stages のインデックス）
+    TileGrid tiles;                 // マップ
+    TileGrid tileMasks;             // タイルの隣接マスク
+    std::vector<Enemy> enemies;     // 配置済みの敵
+    std::vector<Item> items;        // 配置済みのアイテム
+    Goal* goal;                     // ゴール（所有する）
+    SpatialGrid itemIndex;          // アイテムの描画用空間インデックス
+
+    PreparedStage(int cellSize) : stageIndex(-1), goal(nullptr), itemIndex(cellSize) {}
+    ~PreparedStage() { delete goal; }
+
+private:
+    // コピー禁止（ゴールの二重解放を防ぐ）
+    PreparedStage(const PreparedStage&) = delete;
+    PreparedStage& operator=(const PreparedStage&) = delete;
+};
+
+// ステージの先読み: プレイ中に次のステージの実行時状態をワーカースレッドで作っておき、
+// ステージ遷移ではポインタの入れ替えだけで済むようにする
+// 入れ替えで不要になった前のステージの状態もワーカースレッドで破棄する
+class StagePreloader {
+public:
+    // ステージデータから実行時状態を作る関数（ワーカースレッドで呼ばれる）
+    typedef PreparedStage* (*Builder)(const StageData& stage);
+
+    // コンストラクタ: ワーカースレッドを起動
+    StagePreloader(Builder builder);
+    // デストラクタ: ワーカースレッドを停止し、未使用の状態を破棄
+    ~StagePreloader();
+
+    // 先読みを要求（まだ作っていない以前の要求は置き換える）
+    void Request(int stageIndex, const StageData& stage);
+    // 先読み済みの状態を取り出す（作成中なら完了を待つ、要求されていなければnullptr）
+    PreparedStage* Take(int stageIndex);
+    // 不要になった状態をワーカースレッドで破棄する
+    void Recycle(PreparedStage* stage);
+    // ステージの先読みを無効にする（待たずに戻る: 作成済み・未着手なら捨て、作成中なら完成後に捨てる）
+    void Invalidate(int stageIndex);
+
+private:
+    Builder builder;
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable workCondition;      // 要求・破棄の通知
+    std::condition_variable doneCondition;      // 作成完了の通知
+    bool stopping;
+
+    bool hasRequest;                            // 未着手の要求があるか
+    int requestIndex;                           // 要求されたステージ番号
+    StageData requestStage;                     // 要求されたステージデータ（コピー）
+    int buildingIndex;                          // 作成中のステージ番号（-1=なし）
+    bool buildingStale;                         // 作成中の状態が無効になったか（完成しても ready にしない）
+    PreparedStage* ready;                       // 作成済みの状態
+    std::vector<PreparedStage*> garbage;        // 破棄待ちの状態
+
+    // ワーカースレッドのメインループ
+    void WorkerLoop();
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <vector>
+#include <type_traits>
+
+#include "TileGrid.h"
+#include "Enemy.h"
+#include "Item.h"
+#include "Goal.h"
+
+// 敵・アイテム・ゴールはポインタを持たない値型なので、配列ごとの一括コピーで復元できる
+static_assert(std::is_trivially_copyable<Enemy>::value, "Enemy must stay trivially copyable for stage snapshots");
+static_assert(std::is_trivially_copyable<Item>::value, "Item must stay trivially copyable for stage snapshots");
+static_assert(std::is_trivially_copyable<Goal>::value, "Goal must stay trivially copyable for stage snapshots");
+
+// 読み込み直後のステージ状態のスナップショット（リスタート時にそのまま書き戻す）
+// 配列はリスタートのたびに確保し直さないよう、書き戻し先と同じ容量を使い回す
+struct StageSnapshot {
+    int stageIndex;                 // スナップショットを取ったステージ番号（-1=なし）
+    TileGrid tiles;                 // マップ
+    TileGrid tileMasks;             // タイルの隣接マスク
+    std::vector<Enemy> enemies;     // 初期配置の敵
+    std::vector<Item> items;        // 初期配置のアイテム
+    Goal goal;                      // 初期状態のゴール
+
+    StageSnapshot() : stageIndex(-1), goal(0, 0, GOAL_FLAG) {}
+};
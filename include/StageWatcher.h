@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+
+// ステージファイルの変更監視: ファイルが置き換えられたら次の Poll で報告する
+// Linux では inotify でディレクトリを監視し、それ以外の環境では更新時刻を定期的に確認する
+// ステージファイルはメモリマップして使うため、更新は別名に書いてから rename で置き換えること（stagec はそうする）
+// その場で書き換えると、マップ中の内容が書き込み途中で変わってしまう（そのため書き込み完了は監視しない）
+class StageWatcher {
+public:
+    StageWatcher();
+    // デストラクタ: 監視を終了
+    ~StageWatcher();
+
+    // ファイルを監視対象に追加（rename による置き換えを検出する）
+    bool Watch(const std::string& path);
+    // 前回の呼び出し以降に変更された監視対象のパスを changed に追加（毎フレーム呼んでよい）
+    void Poll(std::vector<std::string>& changed);
+
+private:
+    static const int POLL_INTERVAL_FRAMES = 30;     // 更新時刻を確認する間隔（inotifyが使えない場合）
+
+    int inotifyFd;                                  // inotify（使えなければ-1）
+    std::map<int, std::string> watchedDirectories;  // 監視中のディレクトリ（inotifyの監視番号→パス）
+    std::map<std::string, long long> files;         // 監視対象のパスと最終更新時刻
+    int pollCountdown;                              // 次に更新時刻を確認するまでのフレーム数
+
+    // ファイルの最終更新時刻（取得できなければ-1）
+    static long long ModifiedTime(const std::string& path);
+    // inotifyのイベントを読み出す
+    void ReadEvents(std::set<std::string>& changed);
+    // 更新時刻を比較して変更を検出する
+    void ScanModifiedTimes(std::set<std::string>& changed);
+};
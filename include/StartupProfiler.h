@@ -0,0 +1,55 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+#include <mutex>
+#include <thread>
+
+// 起動プロファイラ: 起動処理の各段階（フェーズ）の開始・終了時刻をスレッドごとに記録し、
+// 最初のフレームを表示するまでのタイムラインをコンソールに出力する
+// フェーズはワーカースレッドからも記録できる（計測中でなければ何もしない）
+class StartupProfiler {
+public:
+    // 記録した1フェーズ
+    struct Phase {
+        const char* name;      // フェーズ名
+        int thread;            // スレッド番号（0=計測を開始したスレッド）
+        Uint64 start;          // 開始時刻（パフォーマンスカウンタ）
+        Uint64 end;            // 終了時刻
+    };
+
+    // 計測を開始（呼び出したスレッドをメインスレッドとする）
+    static void Start();
+    // 計測を打ち切る（レポートは出さない）
+    static void Stop();
+    static bool IsRunning();
+
+    // フェーズを記録（StartupPhase から呼ばれる）
+    static void Record(const char* name, Uint64 start, Uint64 end);
+    // 最初のフレームを表示した時刻を記録（2回目以降は無視）
+    static void MarkFirstFrame();
+    // タイムラインをコンソールに出力して計測を終了
+    static void PrintReport();
+
+private:
+    static std::mutex mutex;
+    static bool running;
+    static Uint64 startTime;                    // 計測開始時刻
+    static Uint64 firstFrameTime;               // 最初のフレームの表示時刻（0=未表示）
+    static std::vector<Phase> phases;           // 記録したフェーズ（記録順）
+    static std::vector<std::thread::id> threads; // スレッド番号の対応表
+
+    // 呼び出し元スレッドの番号（mutex を持った状態で呼ぶ）
+    static int ThreadNumber();
+};
+
+// スコープの間を1つの起動フェーズとして計測するヘルパー
+class StartupPhase {
+public:
+    StartupPhase(const char* name) : name(name), start(SDL_GetPerformanceCounter()) {}
+    ~StartupPhase() { StartupProfiler::Record(name, start, SDL_GetPerformanceCounter()); }
+
+private:
+    const char* name;
+    Uint64 start;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <SDL.h>
+#include <vector>
+#include "TileProperties.h"
+
+// タイルグリッド: 実行時に幅・高さを決められる2次元タイル配列
+// 1タイル1バイトで行優先（y * width + x）の連続したメモリに格納する
+// ストリーミング時は横長のステージの一部の列（ウィンドウ）だけを保持し、
+// 座標は常にステージ全体のタイル座標で指定する（ウィンドウ外は空タイル扱い）
+class TileGrid {
+public:
+    // 1タイルのピクセルサイズ
+    static const int TILE_SIZE = 32;
+
+    // コンストラクタ: 空のグリッド（0 x 0）
+    TileGrid();
+    // コンストラクタ: 幅・高さ（タイル単位）を指定し、空タイルで埋める
+    TileGrid(int width, int height);
+
+    // サイズを変更し、全タイルを空にする（ウィンドウ設定は解除される）
+    void Resize(int width, int height);
+    // 保持している列をステージ全体のどこに置くかを設定（originX: 先頭列, worldWidth: ステージ全体の幅）
+    void SetWindow(int originX, int worldWidth);
+    // 全タイルを指定の値で埋める
+    void Fill(Uint8 value);
+    // 行優先のタイル列（width * height バイト）をまとめてコピーする
+    void Assign(const Uint8* data, int width, int height);
+
+    // 保持している列数・行数
+    int Width() const { return width; }
+    int Height() const { return height; }
+    // 保持している列の範囲（OriginX() <= x < EndX()）
+    int OriginX() const { return originX; }
+    int EndX() const { return originX + width; }
+    // ステージ全体の幅（タイル単位、ウィンドウでなければ Width() と同じ）
+    int WorldWidth() const { return worldWidth; }
+    // ワールド全体のピクセルサイズ
+    int PixelWidth() const { return worldWidth * TILE_SIZE; }
+    int PixelHeight() const { return height * TILE_SIZE; }
+
+    // 座標が保持している範囲内かどうか
+    bool InBounds(int x, int y) const {
+        return x >= originX && x < originX + width && y >= 0 && y < height;
+    }
+
+    // 範囲チェック付きの取得（範囲外は空タイルを返す）
+    Uint8 At(int x, int y) const {
+        return InBounds(x, y) ? tiles[y * width + (x - originX)] : (Uint8)TILE_EMPTY;
+    }
+    // 範囲チェックなしの取得（呼び出し側で範囲を保証するループ用）
+    Uint8 AtUnchecked(int x, int y) const { return tiles[y * width + (x - originX)]; }
+
+    // 範囲チェック付きの設定（範囲外は無視）
+    void Set(int x, int y, Uint8 value) {
+        if (InBounds(x, y)) tiles[y * width + (x - originX)] = value;
+    }
+    // 範囲チェックなしの設定
+    void SetUnchecked(int x, int y, Uint8 value) { tiles[y * width + (x - originX)] = value; }
+
+    // タイルのプロパティ（範囲外は空タイルのプロパティ）
+    const TileProperties& Properties(int x, int y) const { return TILE_PROPERTIES[At(x, y)]; }
+    // タイルが指定フラグ（TilePropertyFlag）のどれかを持つか
+    bool Has(int x, int y, Uint8 flags) const { return (TILE_PROPERTIES[At(x, y)].flags & flags) != 0; }
+    // ブロック（当たり判定のあるタイル）かどうか（範囲外はブロックなし）
+    bool IsSolid(int x, int y) const { return Has(x, y, TILE_PROP_SOLID); }
+
+    // 1行分の先頭ポインタ（保持している先頭列から、範囲チェックなし）
+    const Uint8* Row(int y) const { return tiles.data() + y * width; }
+    Uint8* Row(int y) { return tiles.data() + y * width; }
+
+private:
+    int width, height;          // 保持しているタイル数（列・行）
+    int originX;                // 保持している先頭列のステージ内位置
+    int worldWidth;             // ステージ全体の幅（タイル単位）
+    std::vector<Uint8> tiles;   // 行優先のタイルデータ
+};
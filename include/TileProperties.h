@@ -0,0 +1,85 @@
+#pragma once
+
+#include <SDL.h>
+
+// タイルの種類（1タイル = 1バイト）
+// 振る舞いはすべて下のプロパティ表で決まるので、種類を増やしても判定処理は変わらない
+enum TileType {
+    TILE_EMPTY = 0,     // 空
+    TILE_BLOCK = 1,     // 地面ブロック
+    TILE_PLATFORM = 2,  // すり抜け床（下からは通り抜け、上からは着地できる）
+    TILE_SPIKES = 3,    // トゲ（乗るとダメージ）
+    TILE_ICE = 4        // 氷ブロック（滑りやすい）
+};
+
+// タイルのプロパティフラグ（TileProperties::flags のビット）
+enum TilePropertyFlag {
+    TILE_PROP_SOLID = 1,      // 全方向の当たり判定がある
+    TILE_PROP_ONE_WAY = 2,    // 落下中だけ上面に着地できる
+    TILE_PROP_HAZARD = 4,     // 触れるとダメージを受ける
+    TILE_PROP_OCCLUDER = 8,   // 光を遮る
+    TILE_PROP_VISIBLE = 16,   // 描画するタイル
+
+    // 着地できるタイル（落下中の足元判定用）
+    TILE_PROP_STANDABLE = TILE_PROP_SOLID | TILE_PROP_ONE_WAY
+};
+
+// タイルの描画バリエーション（タイルアトラスの行番号）
+enum TileRenderVariant {
+    TILE_RENDER_BLOCK = 0,     // 地面ブロック（隣接マスクで縁取り）
+    TILE_RENDER_PLATFORM = 1,  // すり抜け床
+    TILE_RENDER_SPIKES = 2,    // トゲ
+    TILE_RENDER_ICE = 3,       // 氷ブロック（隣接マスクで縁取り）
+    TILE_RENDER_VARIANTS = 4   // バリエーション数（アトラスの行数）
+};
+
+// 摩擦（1フレームごとに残る水平速度の割合 x 255）
+const Uint8 TILE_FRICTION_NORMAL = 204;  // 0.8（空中も同じ）
+const Uint8 TILE_FRICTION_ICE = 242;     // 約0.95
+
+// 1タイル種類分のプロパティ（4バイトに詰めて、1回の読み込みで全部取れるようにする）
+struct TileProperties {
+    Uint8 flags;          // TilePropertyFlag の組み合わせ
+    Uint8 friction;       // 摩擦（TILE_FRICTION_*）
+    Uint8 renderVariant;  // TileRenderVariant
+    Uint8 reserved;       // 予約（0）
+
+    // 残る水平速度の割合（0.0-1.0）
+    float FrictionFactor() const { return friction / 255.0f; }
+};
+static_assert(sizeof(TileProperties) == 4, "TileProperties は4バイトに収める");
+
+// タイルID（0-255）すべてを引けるプロパティ表
+// 未定義のIDは空タイルと同じ扱いになるので、引く前に範囲チェックはいらない
+struct TilePropertyTable {
+    TileProperties entries[256];
+
+    constexpr const TileProperties& operator[](Uint8 tile) const { return entries[tile]; }
+};
+
+// コンパイル時にプロパティ表を組み立てる
+constexpr TilePropertyTable MakeTilePropertyTable() {
+    TilePropertyTable table = {};
+    for (int i = 0; i < 256; i++) {
+        table.entries[i] = {0, TILE_FRICTION_NORMAL, 0, 0};
+    }
+    table.entries[TILE_BLOCK] = {TILE_PROP_SOLID | TILE_PROP_OCCLUDER | TILE_PROP_VISIBLE,
+                                 TILE_FRICTION_NORMAL, TILE_RENDER_BLOCK, 0};
+    table.entries[TILE_PLATFORM] = {TILE_PROP_ONE_WAY | TILE_PROP_VISIBLE,
+                                    TILE_FRICTION_NORMAL, TILE_RENDER_PLATFORM, 0};
+    table.entries[TILE_SPIKES] = {TILE_PROP_SOLID | TILE_PROP_HAZARD | TILE_PROP_VISIBLE,
+                                  TILE_FRICTION_NORMAL, TILE_RENDER_SPIKES, 0};
+    table.entries[TILE_ICE] = {TILE_PROP_SOLID | TILE_PROP_OCCLUDER | TILE_PROP_VISIBLE,
+                               TILE_FRICTION_ICE, TILE_RENDER_ICE, 0};
+    return table;
+}
+
+inline constexpr TilePropertyTable TILE_PROPERTIES = MakeTilePropertyTable();
+
+// タイルIDのプロパティを取得（表を1回引くだけ）
+inline const TileProperties& GetTileProperties(Uint8 tile) { return TILE_PROPERTIES[tile]; }
+// タイルIDが指定フラグのどれかを持つか
+inline bool TileHas(Uint8 tile, Uint8 flags) { return (TILE_PROPERTIES[tile].flags & flags) != 0; }
+
+static_assert(!TILE_PROPERTIES[TILE_EMPTY].flags, "空タイルはフラグを持たない");
+static_assert(TILE_PROPERTIES[TILE_BLOCK].flags & TILE_PROP_SOLID, "地面ブロックは当たり判定を持つ");
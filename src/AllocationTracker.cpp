@@ -0,0 +1,186 @@
+#include "AllocationTracker.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// 静的メンバの定義
+const int AllocationTracker::MAX_ZONES;
+const int AllocationTracker::MAX_DEPTH;
+bool AllocationTracker::enabled = false;
+int AllocationTracker::frameAllocations = 0;
+size_t AllocationTracker::frameBytes = 0;
+int AllocationTracker::currentAllocations = 0;
+size_t AllocationTracker::currentBytes = 0;
+AllocationTracker::ZoneStats AllocationTracker::zones[MAX_ZONES];
+int AllocationTracker::zoneCount = 0;
+int AllocationTracker::zoneStack[MAX_DEPTH];
+int AllocationTracker::zoneDepth = 0;
+
+namespace {
+
+// 計測するスレッド（SetEnabled を呼んだスレッド）かどうか
+// 他のスレッドは enabled などを読まずにここで戻るので、ロックは要らない
+thread_local bool trackedThread = false;
+
+} // namespace
+
+bool AllocationTracker::IsAvailable() {
+#ifdef TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+// 計測の有効化・無効化（有効にした時点から集計し直す）
+void AllocationTracker::SetEnabled(bool enable) {
+    trackedThread = enable;
+    enabled = enable;
+    frameAllocations = 0;
+    frameBytes = 0;
+    currentAllocations = 0;
+    currentBytes = 0;
+    zoneCount = 0;
+    zoneDepth = 0;
+}
+
+// フレームの始め
+void AllocationTracker::BeginFrame() {
+    if (!enabled) return;
+    frameAllocations = currentAllocations;
+    frameBytes = currentBytes;
+    currentAllocations = 0;
+    currentBytes = 0;
+    for (int i = 0; i < zoneCount; i++) {
+        ZoneStats& zone = zones[i];
+        zone.frameAllocations = zone.currentAllocations;
+        zone.frameBytes = zone.currentBytes;
+        zone.currentAllocations = 0;
+        zone.currentBytes = 0;
+    }
+}
+
+// 計測ゾーンの開始
+void AllocationTracker::BeginZone(const char* name) {
+    if (!enabled) return;
+    if (zoneDepth >= MAX_DEPTH) {
+        zoneDepth++;
+        return;
+    }
+
+    // 同名のゾーンを探す（ゾーン数は少ないので線形探索）
+    int index = -1;
+    for (int i = 0; i < zoneCount; i++) {
+        if (zones[i].name == name || strcmp(zones[i].name, name) == 0) {
+            index = i;
+            break;
+        }
+    }
+    if (index < 0 && zoneCount < MAX_ZONES) {
+        index = zoneCount++;
+        zones[index] = {name, 0, 0, 0, 0, 0, 0};
+    }
+    // ゾーンの表が一杯なら外側のゾーンに数える
+    zoneStack[zoneDepth] = index >= 0 ? index : (zoneDepth > 0 ? zoneStack[zoneDepth - 1] : -1);
+    zoneDepth++;
+}
+
+// 計測ゾーンの終了
+void AllocationTracker::EndZone() {
+    if (!enabled || zoneDepth == 0) return;
+    zoneDepth--;
+}
+
+// 確保を1回数える
+void AllocationTracker::Count(size_t size) {
+    if (!trackedThread || !enabled) return;
+    currentAllocations++;
+    currentBytes += size;
+
+    if (zoneDepth == 0) return;
+    int index = zoneStack[(zoneDepth < MAX_DEPTH ? zoneDepth : MAX_DEPTH) - 1];
+    if (index < 0) return;
+    ZoneStats& zone = zones[index];
+    zone.currentAllocations++;
+    zone.currentBytes += size;
+    zone.totalAllocations++;
+    zone.totalBytes += size;
+}
+
+#ifdef TRACK_ALLOCATIONS
+
+// === グローバルな operator new / delete の置き換え ===
+
+namespace {
+
+void* TrackedAllocate(size_t size) {
+    AllocationTracker::Count(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* TrackedAllocateAligned(size_t size, size_t alignment) {
+    AllocationTracker::Count(size);
+    if (size == 0) size = 1;
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    void* pointer = nullptr;
+    if (alignment < sizeof(void*)) alignment = sizeof(void*);
+    return posix_memalign(&pointer, alignment, size) == 0 ? pointer : nullptr;
+#endif
+}
+
+void FreeAligned(void* pointer) {
+#ifdef _WIN32
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    void* pointer = TrackedAllocate(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](size_t size) {
+    void* pointer = TrackedAllocate(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return TrackedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return TrackedAllocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    void* pointer = TrackedAllocateAligned(size, (size_t)alignment);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    void* pointer = TrackedAllocateAligned(size, (size_t)alignment);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { FreeAligned(pointer); }
+
+#endif  // TRACK_ALLOCATIONS
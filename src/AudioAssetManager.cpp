@@ -0,0 +1,86 @@
+#ifdef SOUND_ENABLED
+
+#include "AudioAssetManager.h"
+#include "StartupProfiler.h"
+#include <iostream>
+
+// 静的メンバの定義
+const AudioAssetManager::Handle AudioAssetManager::INVALID_HANDLE;
+const int AudioAssetManager::MAX_ASSETS;
+
+// コンストラクタ: ワーカースレッドを起動
+AudioAssetManager::AudioAssetManager() : assetCount(0), stopping(false) {
+    for (Asset& asset : assets) {
+        asset.chunk = nullptr;
+    }
+    worker = std::thread(&AudioAssetManager::WorkerLoop, this);
+}
+
+// デストラクタ: ワーカースレッドを停止し、読み込んだデータをすべて解放
+AudioAssetManager::~AudioAssetManager() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workCondition.notify_all();
+    worker.join();
+
+    int count = assetCount.load();
+    for (int i = 0; i < count; i++) {
+        if (assets[i].chunk) Mix_FreeChunk(assets[i].chunk);
+    }
+}
+
+// 効果音の読み込みを要求（キャッシュにあればそのハンドルを返す）
+AudioAssetManager::Handle AudioAssetManager::RequestSound(const std::string& path) {
+    auto found = handles.find(path);
+    if (found != handles.end()) return found->second;
+
+    int handle = assetCount.load();
+    if (handle >= MAX_ASSETS) {
+        std::cout << "⚠️ オーディオアセットの上限に達しました: " << path << std::endl;
+        return INVALID_HANDLE;
+    }
+    Asset& asset = assets[handle];
+    asset.path = path;
+    handles[path] = handle;
+    assetCount = handle + 1;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(handle);
+    }
+    workCondition.notify_one();
+    return handle;
+}
+
+// 読み込み済みの効果音を取得
+Mix_Chunk* AudioAssetManager::GetSound(Handle handle) const {
+    if (handle < 0 || handle >= MAX_ASSETS) return nullptr;
+    return assets[handle].chunk.load(std::memory_order_acquire);
+}
+
+// ワーカースレッドのメインループ
+void AudioAssetManager::WorkerLoop() {
+    while (true) {
+        Handle handle;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workCondition.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+            handle = queue.front();
+            queue.pop_front();
+        }
+
+        // ファイルを開くのは1回だけ（存在しない場合もここで失敗する）
+        Asset& asset = assets[handle];
+        StartupPhase phase("audio decode");  // 起動中のみ記録される
+        Mix_Chunk* chunk = Mix_LoadWAV(asset.path.c_str());
+        asset.chunk.store(chunk, std::memory_order_release);
+        if (!chunk) {
+            std::cout << "⚠️ サウンド読み込みエラー: " << asset.path << " (" << Mix_GetError() << ")" << std::endl;
+        }
+    }
+}
+
+#endif  // SOUND_ENABLED
@@ -0,0 +1,156 @@
+#ifdef SOUND_ENABLED
+
+#include "AudioThread.h"
+#include <iostream>
+#include <chrono>
+
+// 静的メンバの定義
+const AudioThread::MusicTrack AudioThread::INVALID_TRACK;
+const int AudioThread::MAX_MUSIC_TRACKS;
+const int AudioThread::IDLE_SLEEP_MS;
+
+// コンストラクタ: 効果音ミキサーを作り、オーディオスレッドを起動
+AudioThread::AudioThread(AudioAssetManager* assets, MusicPlayer* musicPlayer)
+    : musicPlayer(musicPlayer), mixer(new SoundMixer(assets)),
+      stopping(false), droppedCommands(0), musicCount(0) {
+    worker = std::thread(&AudioThread::WorkerLoop, this);
+}
+
+// デストラクタ: スレッドを終了してからすべての効果音を止める
+AudioThread::~AudioThread() {
+    stopping.store(true, std::memory_order_release);
+    worker.join();
+    mixer->StopAll();
+    delete mixer;
+}
+
+// === ゲームスレッドから呼ぶ ===
+
+void AudioThread::PlaySound(AudioAssetManager::Handle sound, int priority) {
+    if (sound == AudioAssetManager::INVALID_HANDLE) return;
+    Push(AUDIO_PLAY_SOUND, sound, (Uint32)priority);
+}
+
+void AudioThread::PlaySoundAt(AudioAssetManager::Handle sound, int priority, float x, float y) {
+    if (sound == AudioAssetManager::INVALID_HANDLE) return;
+    Push(AUDIO_PLAY_SOUND_AT, sound, (Uint32)priority, x, y);
+}
+
+void AudioThread::EndFrame(Uint32 now, float listenerX, float listenerY) {
+    Push(AUDIO_END_FRAME, 0, now, listenerX, listenerY);
+}
+
+void AudioThread::SetSoundVolume(int volume) {
+    Push(AUDIO_SET_SOUND_VOLUME, 0, (Uint32)volume);
+}
+
+void AudioThread::SetMusicVolume(int volume) {
+    Push(AUDIO_SET_MUSIC_VOLUME, 0, (Uint32)volume);
+}
+
+void AudioThread::StopSounds() {
+    Push(AUDIO_STOP_SOUNDS);
+}
+
+// BGMの曲番号を取得（初めてのパスは登録する）
+AudioThread::MusicTrack AudioThread::RegisterMusic(const std::string& path, const std::string& fallbackPath) {
+    auto found = musicTracks.find(path);
+    if (found != musicTracks.end()) return found->second;
+
+    int track = musicCount.load(std::memory_order_relaxed);
+    if (track >= MAX_MUSIC_TRACKS) {
+        std::cout << "⚠️ BGMの登録数の上限に達しました: " << path << std::endl;
+        return INVALID_TRACK;
+    }
+    musicEntries[track].path = path;
+    musicEntries[track].fallbackPath = fallbackPath;
+    musicTracks[path] = track;
+    musicCount.store(track + 1, std::memory_order_release);  // 書き終えてから公開する
+    return track;
+}
+
+void AudioThread::PlayMusic(MusicTrack track) {
+    if (track == INVALID_TRACK) return;
+    Push(AUDIO_PLAY_MUSIC, track);
+}
+
+void AudioThread::PrefetchMusic(MusicTrack track) {
+    if (track == INVALID_TRACK) return;
+    Push(AUDIO_PREFETCH_MUSIC, track);
+}
+
+void AudioThread::StopMusic() {
+    Push(AUDIO_STOP_MUSIC);
+}
+
+// コマンドを積む（満杯なら捨てて数える）
+void AudioThread::Push(AudioCommandType type, int id, Uint32 value, float x, float y) {
+    if (!queue.Push({(Uint32)type, id, value, x, y})) {
+        droppedCommands.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// === オーディオスレッド ===
+
+// オーディオスレッドのメインループ
+void AudioThread::WorkerLoop() {
+    AudioCommand command;
+    while (true) {
+        bool executed = false;
+        while (queue.Pop(command)) {
+            Execute(command);
+            executed = true;
+        }
+        if (executed) continue;
+        // 終了要求は積まれたコマンドを実行し終えてから確認する
+        if (stopping.load(std::memory_order_acquire)) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(IDLE_SLEEP_MS));
+    }
+}
+
+// コマンドを1つ実行
+void AudioThread::Execute(const AudioCommand& command) {
+    switch (command.type) {
+        case AUDIO_PLAY_SOUND:
+            mixer->Post(command.id, (int)command.value);
+            break;
+        case AUDIO_PLAY_SOUND_AT:
+            mixer->PostAt(command.id, (int)command.value, command.x, command.y);
+            break;
+        case AUDIO_END_FRAME:
+            mixer->SetListener(command.x, command.y);
+            mixer->Flush(command.value);
+            break;
+        case AUDIO_SET_SOUND_VOLUME:
+            mixer->SetVolume((int)command.value);
+            break;
+        case AUDIO_SET_MUSIC_VOLUME:
+            // 音楽チャンネルはBGMスレッドだけが操作する
+            musicPlayer->SetVolume((int)command.value);
+            break;
+        case AUDIO_STOP_SOUNDS:
+            mixer->StopAll();
+            break;
+        case AUDIO_PLAY_MUSIC:
+            if (const MusicEntry* entry = GetMusic(command.id)) {
+                musicPlayer->Play(entry->path, entry->fallbackPath);
+            }
+            break;
+        case AUDIO_PREFETCH_MUSIC:
+            if (const MusicEntry* entry = GetMusic(command.id)) {
+                musicPlayer->Prefetch(entry->path, entry->fallbackPath);
+            }
+            break;
+        case AUDIO_STOP_MUSIC:
+            musicPlayer->Stop();
+            break;
+    }
+}
+
+// 登録済みのBGM（公開された範囲だけ読む）
+const AudioThread::MusicEntry* AudioThread::GetMusic(MusicTrack track) const {
+    if (track < 0 || track >= musicCount.load(std::memory_order_acquire)) return nullptr;
+    return &musicEntries[track];
+}
+
+#endif  // SOUND_ENABLED
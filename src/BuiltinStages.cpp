@@ -0,0 +1,448 @@
+#include "BuiltinStages.h"
+#include "Enemy.h"
+#include "Item.h"
+#include "TileGrid.h"
+
+// 組み込みステージのタイル層と配置表はすべてコンパイル時に作る
+// 起動時の処理はステージ一覧にこのテーブルへのポインタを登録するだけになる
+
+namespace {
+
+// 組み込みステージの標準サイズ（タイル単位）
+const int MAP_WIDTH = 100;
+const int MAP_HEIGHT = 19;
+const int TILE_SIZE = TileGrid::TILE_SIZE;
+
+// コンパイル時に組み立てるタイル層
+struct BuiltinTiles {
+    Uint8 tiles[MAP_WIDTH * MAP_HEIGHT];
+
+    constexpr void Set(int x, int y, Uint8 type) {
+        tiles[y * MAP_WIDTH + x] = type;
+    }
+};
+
+// 横スクロール対応の長いステージ1
+constexpr BuiltinTiles BuildStage1Tiles() {
+    BuiltinTiles map{};
+    
+    // === 基本的な地面を作成 ===
+    for (int x = 0; x < MAP_WIDTH; x++) {
+        map.Set(x, MAP_HEIGHT - 1, 1);  // 地面
+        map.Set(x, MAP_HEIGHT - 2, 1);  // 地面（厚み）
+    }
+    
+    // === セクション1: 開始エリア（X: 0-20）===
+    // 最初のプラットフォーム
+    for (int x = 5; x < 8; x++) {
+        map.Set(x, 14, 1);
+    }
+    for (int x = 10; x < 15; x++) {
+        map.Set(x, 12, 1);
+    }
+    
+    // === セクション2: ジャンプチャレンジ（X: 20-40）===
+    // 連続プラットフォーム
+    for (int x = 22; x < 25; x++) {
+        map.Set(x, 13, 1);
+    }
+    for (int x = 27; x < 30; x++) {
+        map.Set(x, 11, 1);
+    }
+    for (int x = 32; x < 35; x++) {
+        map.Set(x, 9, 1);
+    }
+    for (int x = 37; x < 40; x++) {
+        map.Set(x, 11, 1);
+    }
+    
+    // === セクション3: 壁ジャンプエリア（X: 40-60）===
+    // 左側の高い壁
+    for (int y = 10; y < MAP_HEIGHT - 2; y++) {
+        map.Set(42, y, 1);
+    }
+    // 右側の高い壁
+    for (int y = 8; y < MAP_HEIGHT - 2; y++) {
+        map.Set(58, y, 1);
+    }
+    // 中間のプラットフォーム
+    for (int x = 45; x < 48; x++) {
+        map.Set(x, 14, 1);
+    }
+    for (int x = 52; x < 55; x++) {
+        map.Set(x, 10, 1);
+    }
+    
+    // === セクション4: 複雑な地形（X: 60-80）===
+    // 階段状の地形
+    for (int i = 0; i < 8; i++) {
+        for (int y = MAP_HEIGHT - 3 - i; y < MAP_HEIGHT - 1; y++) {
+            map.Set(62 + i, y, 1);
+        }
+    }
+    
+    // 上部プラットフォーム
+    for (int x = 72; x < 78; x++) {
+        map.Set(x, 8, 1);
+    }
+    
+    // === セクション5: ゴールエリア（X: 80-100）===
+    // ゴール前の最終チャレンジ
+    for (int x = 82; x < 85; x++) {
+        map.Set(x, 12, 1);
+    }
+    for (int x = 88; x < 91; x++) {
+        map.Set(x, 10, 1);
+    }
+    
+    // ゴール台座
+    for (int x = 94; x < 98; x++) {
+        for (int y = MAP_HEIGHT - 5; y < MAP_HEIGHT - 1; y++) {
+            map.Set(x, y, 1);
+        }
+    }
+    
+    return map;
+}
+
+// ステージ2 - 地下洞窟
+constexpr BuiltinTiles BuildStage2Tiles() {
+    BuiltinTiles map{};
+    
+    // === 基本地面 ===
+    for (int x = 0; x < MAP_WIDTH; x++) {
+        map.Set(x, MAP_HEIGHT - 1, 1);
+        map.Set(x, MAP_HEIGHT - 2, 1);
+    }
+    
+    // === セクション1: 洞窟入口（X: 0-25）===
+    // 洞窟の天井
+    for (int x = 15; x < MAP_WIDTH; x++) {
+        map.Set(x, 5, 1);
+    }
+    
+    // 入口の鍾乳石
+    for (int x = 8; x < 12; x++) {
+        map.Set(x, 14, 1);
+    }
+    for (int x = 18; x < 22; x++) {
+        map.Set(x, 12, 1);
+    }
+    
+    // === セクション2: 狭い通路（X: 25-45）===
+    // 上下から迫る壁
+    for (int x = 25; x < 45; x++) {
+        map.Set(x, 6, 1);  // 天井
+        if ((x - 25) % 8 < 4) {
+            map.Set(x, 15, 1);  // 床から突き出る障害物
+        }
+    }
+    
+    // === セクション3: 地下湖エリア（X: 45-65）===
+    // 水面（床を少し上に）
+    for (int x = 45; x < 65; x++) {
+        map.Set(x, MAP_HEIGHT - 4, 1);  // 水面の代わりに床
+        map.Set(x, MAP_HEIGHT - 3, 0);  // 元の床を削除
+    }
+    
+    // 飛び石プラットフォーム
+    for (int i = 0; i < 4; i++) {
+        int x = 48 + i * 5;
+        map.Set(x, MAP_HEIGHT - 6, 1);
+        map.Set(x + 1, MAP_HEIGHT - 6, 1);
+    }
+    
+    // === セクション4: クリスタル洞窟（X: 65-85）===
+    // 複雑な上下構造
+    for (int x = 65; x < 85; x++) {
+        if ((x - 65) % 6 < 3) {
+            map.Set(x, 8, 1);   // 上層プラットフォーム
+        }
+        if ((x - 67) % 6 < 3) {
+            map.Set(x, 13, 1);  // 中層プラットフォーム
+        }
+    }
+    
+    // 垂直ブロックチェーン（壁ジャンプ練習）
+    for (int y = 8; y < 14; y++) {
+        map.Set(75, y, 1);
+        map.Set(80, y, 1);
+    }
+    
+    // === セクション5: 洞窟出口（X: 85-100）===
+    // 最終チャレンジ - 急な登り
+    for (int i = 0; i < 7; i++) {
+        for (int y = MAP_HEIGHT - 3 - i; y < MAP_HEIGHT - 1; y++) {
+            map.Set(87 + i, y, 1);
+        }
+    }
+    
+    // ゴール台座
+    for (int x = 90; x < 94; x++) {
+        for (int y = MAP_HEIGHT - 10; y < MAP_HEIGHT - 1; y++) {
+            map.Set(x, y, 1);
+        }
+    }
+    
+    return map;
+}
+
+// ステージ3 - 天空城塞
+constexpr BuiltinTiles BuildStage3Tiles() {
+    BuiltinTiles map{};
+    
+    // === 基本地面（部分的に）===
+    for (int x = 0; x < 20; x++) {
+        map.Set(x, MAP_HEIGHT - 1, 1);
+        map.Set(x, MAP_HEIGHT - 2, 1);
+    }
+    
+    // === セクション1: 地上発射台（X: 0-20）===
+    // 発射台への階段
+    for (int i = 0; i < 5; i++) {
+        for (int y = MAP_HEIGHT - 2 - i; y < MAP_HEIGHT; y++) {
+            map.Set(10 + i, y, 1);
+        }
+    }
+    
+    // === セクション2: 低空エリア（X: 20-40）===
+    // 浮遊プラットフォーム群
+    for (int x = 22; x < 26; x++) {
+        map.Set(x, 14, 1);
+    }
+    for (int x = 30; x < 34; x++) {
+        map.Set(x, 12, 1);
+    }
+    for (int x = 36; x < 40; x++) {
+        map.Set(x, 10, 1);
+    }
+    
+    // === セクション3: 中空エリア（X: 40-60）===
+    // より高い浮遊プラットフォーム
+    for (int x = 42; x < 45; x++) {
+        map.Set(x, 8, 1);
+    }
+    for (int x = 48; x < 51; x++) {
+        map.Set(x, 9, 1);
+    }
+    for (int x = 54; x < 57; x++) {
+        map.Set(x, 7, 1);
+    }
+    
+    // 縦の柱（ジャンプチャレンジ）
+    for (int y = 10; y < 15; y++) {
+        map.Set(46, y, 1);
+        map.Set(52, y, 1);
+    }
+    
+    // === セクション4: 高空エリア（X: 60-80）===
+    // 非常に高いプラットフォーム
+    for (int x = 62; x < 65; x++) {
+        map.Set(x, 5, 1);
+    }
+    for (int x = 68; x < 71; x++) {
+        map.Set(x, 4, 1);
+    }
+    for (int x = 74; x < 77; x++) {
+        map.Set(x, 6, 1);
+    }
+    
+    // 空中の支柱
+    for (int y = 7; y < 12; y++) {
+        map.Set(66, y, 1);
+        map.Set(72, y, 1);
+    }
+    
+    // === セクション5: 天空城塞（X: 80-100）===
+    // 城塞の基礎構造
+    for (int x = 82; x < 90; x++) {
+        for (int y = 5; y < 8; y++) {
+            map.Set(x, y, 1);
+        }
+    }
+    
+    // 城塞の塔
+    for (int y = 3; y < 8; y++) {
+        map.Set(84, y, 1);
+        map.Set(87, y, 1);
+    }
+    
+    // ゴールへの最終階段
+    for (int i = 0; i < 4; i++) {
+        for (int y = 6 + i; y < 8; y++) {
+            map.Set(90 + i, y, 1);
+        }
+    }
+    
+    // ゴール台座（空中）
+    for (int x = 86; x < 90; x++) {
+        map.Set(x, 5, 1);
+    }
+    
+    return map;
+}
+
+// ボスステージ
+constexpr BuiltinTiles BuildBossStageTiles() {
+    BuiltinTiles map{};
+    
+    // シンプルなボス戦用ステージ
+    for (int y = 0; y < MAP_HEIGHT; y++) {
+        for (int x = 0; x < MAP_WIDTH; x++) {
+            if (y == MAP_HEIGHT - 1) {
+                map.Set(x, y, 1);  // 地面
+            } else if (x == 0 || x == MAP_WIDTH - 1) {
+                map.Set(x, y, 1);  // 壁
+            } else {
+                map.Set(x, y, 0);  // 空
+            }
+        }
+    }
+    
+    // プラットフォームを少し追加（ダッシュ・ウォールジャンプ練習用）
+    for (int x = 8; x < 12; x++) {
+        map.Set(x, 15, 1);
+    }
+    for (int x = 13; x < 17; x++) {
+        map.Set(x, 15, 1);
+    }
+    
+    // 壁ジャンプ用の縦壁
+    for (int y = 10; y < 18; y++) {
+        map.Set(5, y, 1);
+        map.Set(19, y, 1);
+    }
+    
+    return map;
+}
+
+constexpr BuiltinTiles STAGE1_TILES = BuildStage1Tiles();
+constexpr BuiltinTiles STAGE2_TILES = BuildStage2Tiles();
+constexpr BuiltinTiles STAGE3_TILES = BuildStage3Tiles();
+constexpr BuiltinTiles BOSS_STAGE_TILES = BuildBossStageTiles();
+
+// 敵の配置（種類は配置順の規則で決めたもの: 0番目=射撃敵, 3番目=追跡敵, 4番目=ジャンプ敵, その他=基本敵）
+constexpr StageFileSpawn STAGE1_ENEMIES[] = {
+    {6 * TILE_SIZE, (MAP_HEIGHT - 3) * TILE_SIZE, ENEMY_SHOOTER},
+    {25 * TILE_SIZE, (MAP_HEIGHT - 3) * TILE_SIZE, ENEMY_GOOMBA},
+    {45 * TILE_SIZE, (MAP_HEIGHT - 3) * TILE_SIZE, ENEMY_GOOMBA},
+    {70 * TILE_SIZE, (MAP_HEIGHT - 3) * TILE_SIZE, ENEMY_CHASER},
+    {85 * TILE_SIZE, (MAP_HEIGHT - 3) * TILE_SIZE, ENEMY_JUMPER},
+};
+
+// アイテムの配置（探索を促すために隠された場所に）
+constexpr StageFileSpawn STAGE1_ITEMS[] = {
+    // セクション1
+    {6 * TILE_SIZE, 13 * TILE_SIZE - 25, COIN},
+    {12 * TILE_SIZE, 11 * TILE_SIZE - 25, COIN},
+    // セクション2
+    {23 * TILE_SIZE, 12 * TILE_SIZE - 25, POWER_MUSHROOM},
+    {33 * TILE_SIZE, 8 * TILE_SIZE - 25, COIN},
+    // セクション3
+    {46 * TILE_SIZE, 13 * TILE_SIZE - 25, LIFE_UP},
+    {53 * TILE_SIZE, 9 * TILE_SIZE - 25, COIN},
+    // セクション4
+    {75 * TILE_SIZE, 7 * TILE_SIZE - 25, COIN},
+    {67 * TILE_SIZE, (MAP_HEIGHT - 8) * TILE_SIZE - 25, COIN},
+    // セクション5
+    {89 * TILE_SIZE, 9 * TILE_SIZE - 25, COIN},
+    {95 * TILE_SIZE, (MAP_HEIGHT - 4) * TILE_SIZE - 25, POWER_MUSHROOM},
+};
+
+// 洞窟生物
+constexpr StageFileSpawn STAGE2_ENEMIES[] = {
+    {10 * TILE_SIZE, (MAP_HEIGHT - 3) * TILE_SIZE, ENEMY_SHOOTER},
+    {30 * TILE_SIZE, (MAP_HEIGHT - 3) * TILE_SIZE, ENEMY_GOOMBA},
+    {50 * TILE_SIZE, (MAP_HEIGHT - 5) * TILE_SIZE, ENEMY_GOOMBA},
+    {70 * TILE_SIZE, (MAP_HEIGHT - 3) * TILE_SIZE, ENEMY_CHASER},
+    {85 * TILE_SIZE, (MAP_HEIGHT - 3) * TILE_SIZE, ENEMY_JUMPER},
+};
+
+// 洞窟の宝物
+constexpr StageFileSpawn STAGE2_ITEMS[] = {
+    // セクション1
+    {10 * TILE_SIZE, 13 * TILE_SIZE - 25, COIN},
+    {20 * TILE_SIZE, 11 * TILE_SIZE - 25, COIN},
+    // セクション2
+    {35 * TILE_SIZE, (MAP_HEIGHT - 3) * TILE_SIZE - 25, POWER_MUSHROOM},
+    // セクション3
+    {50 * TILE_SIZE, (MAP_HEIGHT - 7) * TILE_SIZE - 25, LIFE_UP},
+    {58 * TILE_SIZE, (MAP_HEIGHT - 7) * TILE_SIZE - 25, COIN},
+    // セクション4
+    {70 * TILE_SIZE, 7 * TILE_SIZE - 25, COIN},
+    {77 * TILE_SIZE, 12 * TILE_SIZE - 25, COIN},
+    // セクション5
+    {90 * TILE_SIZE, (MAP_HEIGHT - 8) * TILE_SIZE - 25, COIN},
+    {91 * TILE_SIZE, (MAP_HEIGHT - 11) * TILE_SIZE - 25, POWER_MUSHROOM},
+};
+
+// 空中生物・機械
+constexpr StageFileSpawn STAGE3_ENEMIES[] = {
+    {12 * TILE_SIZE, (MAP_HEIGHT - 3) * TILE_SIZE, ENEMY_SHOOTER},  // 地上
+    {32 * TILE_SIZE, 11 * TILE_SIZE, ENEMY_GOOMBA},                 // 低空
+    {49 * TILE_SIZE, 8 * TILE_SIZE, ENEMY_GOOMBA},                  // 中空
+    {69 * TILE_SIZE, 3 * TILE_SIZE, ENEMY_CHASER},                  // 高空
+    {85 * TILE_SIZE, 4 * TILE_SIZE, ENEMY_JUMPER},                  // 城塞
+};
+
+// 空中の宝物
+constexpr StageFileSpawn STAGE3_ITEMS[] = {
+    // セクション1
+    {12 * TILE_SIZE, (MAP_HEIGHT - 6) * TILE_SIZE - 25, COIN},
+    // セクション2
+    {24 * TILE_SIZE, 13 * TILE_SIZE - 25, COIN},
+    {32 * TILE_SIZE, 11 * TILE_SIZE - 25, POWER_MUSHROOM},
+    {38 * TILE_SIZE, 9 * TILE_SIZE - 25, COIN},
+    // セクション3
+    {43 * TILE_SIZE, 7 * TILE_SIZE - 25, LIFE_UP},
+    {55 * TILE_SIZE, 6 * TILE_SIZE - 25, COIN},
+    // セクション4
+    {63 * TILE_SIZE, 4 * TILE_SIZE - 25, COIN},
+    {75 * TILE_SIZE, 5 * TILE_SIZE - 25, COIN},
+    // セクション5
+    {86 * TILE_SIZE, 4 * TILE_SIZE - 25, COIN},
+    {88 * TILE_SIZE, 4 * TILE_SIZE - 25, POWER_MUSHROOM},
+};
+
+// ボスステージの回復アイテム（敵はボスのみ）
+constexpr StageFileSpawn BOSS_STAGE_ITEMS[] = {
+    {3 * TILE_SIZE, 15 * TILE_SIZE, POWER_MUSHROOM},
+    {21 * TILE_SIZE, 15 * TILE_SIZE, POWER_MUSHROOM},
+    {9 * TILE_SIZE, 13 * TILE_SIZE, LIFE_UP},
+    {15 * TILE_SIZE, 13 * TILE_SIZE, LIFE_UP},
+};
+
+template <typename T, int N>
+constexpr int CountOf(const T (&)[N]) { return N; }
+
+} // namespace
+
+// 組み込みステージの一覧（遊ぶ順）
+const BuiltinStage BUILTIN_STAGES[] = {
+    // ステージ1: 基本的なプラットフォームアクション（横スクロール対応）
+    {1, "Stage 1 - Long Journey", GOAL_FLAG,
+     98 * TILE_SIZE, (MAP_HEIGHT - 6) * TILE_SIZE - 32,  // 台座の上
+     100, 300, 0, "",
+     MAP_WIDTH, MAP_HEIGHT, STAGE1_TILES.tiles,
+     STAGE1_ENEMIES, CountOf(STAGE1_ENEMIES), STAGE1_ITEMS, CountOf(STAGE1_ITEMS)},
+    // ステージ2: より複雑な地形（制限時間4分）
+    {2, "Stage 2 - Underground Cave", GOAL_FLAG,
+     94 * TILE_SIZE, (MAP_HEIGHT - 11) * TILE_SIZE - 32,  // 台座の上
+     100, 300, 240, "",
+     MAP_WIDTH, MAP_HEIGHT, STAGE2_TILES.tiles,
+     STAGE2_ENEMIES, CountOf(STAGE2_ENEMIES), STAGE2_ITEMS, CountOf(STAGE2_ITEMS)},
+    // ステージ3: 最終ステージ（制限時間5分）
+    {3, "Stage 3 - Sky Fortress", GOAL_DOOR,
+     90 * TILE_SIZE, 4 * TILE_SIZE,  // 台座の上
+     100, 300, 300, "",
+     MAP_WIDTH, MAP_HEIGHT, STAGE3_TILES.tiles,
+     STAGE3_ENEMIES, CountOf(STAGE3_ENEMIES), STAGE3_ITEMS, CountOf(STAGE3_ITEMS)},
+    // ボスステージ: 強大なボスとの戦い（ボス撃破でクリア）
+    {4, "Boss Stage - Final Battle", GOAL_FLAG,
+     80 * TILE_SIZE, 16 * TILE_SIZE,  // ボス戦エリアの右端
+     100, 300, 0, "boss_battle.ogg",
+     MAP_WIDTH, MAP_HEIGHT, BOSS_STAGE_TILES.tiles,
+     nullptr, 0, BOSS_STAGE_ITEMS, CountOf(BOSS_STAGE_ITEMS)},
+};
+
+const int BUILTIN_STAGE_COUNT = CountOf(BUILTIN_STAGES);
@@ -0,0 +1,174 @@
+#include "ChunkSource.h"
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <algorithm>
+
+namespace {
+
+// ファイルの識別子とバージョン
+const Uint32 LEVEL_MAGIC = 0x434C564C;  // "LVLC"
+const Uint32 CHUNK_MAGIC = 0x4B4E4843;  // "CHNK"
+const Uint32 CHUNK_FORMAT_VERSION = 1;
+
+void WriteInt(std::ofstream& file, Sint32 value) {
+    file.write((const char*)&value, sizeof(value));
+}
+
+bool ReadInt(std::ifstream& file, Sint32& value) {
+    return (bool)file.read((char*)&value, sizeof(value));
+}
+
+void WriteSpawns(std::ofstream& file, const std::vector<ChunkSpawn>& spawns) {
+    WriteInt(file, (Sint32)spawns.size());
+    for (const ChunkSpawn& spawn : spawns) {
+        WriteInt(file, spawn.x);
+        WriteInt(file, spawn.y);
+        WriteInt(file, spawn.type);
+    }
+}
+
+// ファイルの残りのバイト数
+std::streamoff RemainingBytes(std::ifstream& file) {
+    std::streampos position = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streamoff remaining = file.tellg() - position;
+    file.seekg(position);
+    return remaining;
+}
+
+bool ReadSpawns(std::ifstream& file, std::vector<ChunkSpawn>& spawns) {
+    Sint32 count = 0;
+    if (!ReadInt(file, count) || count < 0) return false;
+    // 壊れたファイルの個数で巨大な確保をしないよう、残りのデータに収まる個数か確かめてから確保する
+    if ((std::streamoff)count * 3 * (std::streamoff)sizeof(Sint32) > RemainingBytes(file)) return false;
+    spawns.resize(count);
+    for (ChunkSpawn& spawn : spawns) {
+        Sint32 x, y, type;
+        if (!ReadInt(file, x) || !ReadInt(file, y) || !ReadInt(file, type)) return false;
+        spawn = {x, y, type};
+    }
+    return true;
+}
+
+} // namespace
+
+// コンストラクタ
+FileChunkSource::FileChunkSource(const std::string& directory) : directory(directory) {
+}
+
+// チャンクファイルのパス
+std::string FileChunkSource::ChunkPath(const std::string& directory, int index) {
+    char name[32];
+    snprintf(name, sizeof(name), "/chunk_%04d.dat", index);
+    return directory + name;
+}
+
+// ステージ全体の情報を読み込む
+bool FileChunkSource::ReadInfo(LevelInfo& info) {
+    std::ifstream file(directory + "/level.dat", std::ios::binary);
+    if (!file) {
+        std::cout << "❌ ステージ情報を開けません: " << directory << "/level.dat" << std::endl;
+        return false;
+    }
+
+    Sint32 magic, version;
+    if (!ReadInt(file, magic) || !ReadInt(file, version) ||
+        (Uint32)magic != LEVEL_MAGIC || (Uint32)version != CHUNK_FORMAT_VERSION) {
+        std::cout << "❌ ステージ情報の形式が不正です: " << directory << std::endl;
+        return false;
+    }
+
+    Sint32 values[10];
+    for (Sint32& value : values) {
+        if (!ReadInt(file, value)) return false;
+    }
+    info = {values[0], values[1], values[2], values[3], values[4], values[5], values[6], values[7], values[8], values[9]};
+    return info.chunkWidth > 0 && info.chunkCount > 0 && info.height > 0 &&
+           info.width > (info.chunkCount - 1) * info.chunkWidth && info.width <= info.chunkCount * info.chunkWidth;
+}
+
+// 指定番号のチャンクを読み込む
+bool FileChunkSource::LoadChunk(int index, LevelChunk& chunk) {
+    std::ifstream file(ChunkPath(directory, index), std::ios::binary);
+    if (!file) {
+        std::cout << "❌ チャンクを開けません: " << ChunkPath(directory, index) << std::endl;
+        return false;
+    }
+
+    Sint32 magic, version, fileIndex, width, height;
+    if (!ReadInt(file, magic) || !ReadInt(file, version) || !ReadInt(file, fileIndex) ||
+        !ReadInt(file, width) || !ReadInt(file, height) ||
+        (Uint32)magic != CHUNK_MAGIC || (Uint32)version != CHUNK_FORMAT_VERSION ||
+        fileIndex != index || width <= 0 || height <= 0 ||
+        (std::streamoff)width * height > RemainingBytes(file)) {
+        std::cout << "❌ チャンクの形式が不正です: " << index << std::endl;
+        return false;
+    }
+
+    chunk.index = index;
+    chunk.tiles.resize((size_t)width * height);
+    if (!file.read((char*)chunk.tiles.data(), chunk.tiles.size()) ||
+        !ReadSpawns(file, chunk.enemies) || !ReadSpawns(file, chunk.items)) {
+        std::cout << "❌ チャンクの形式が不正です: " << index << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ステージ全体をチャンクファイルに書き出す
+bool FileChunkSource::WriteLevel(const std::string& directory, const LevelInfo& info, const TileGrid& tiles,
+                                 const std::vector<ChunkSpawn>& enemies, const std::vector<ChunkSpawn>& items) {
+    std::ofstream levelFile(directory + "/level.dat", std::ios::binary);
+    if (!levelFile) {
+        std::cout << "❌ ステージ情報を書き込めません: " << directory << std::endl;
+        return false;
+    }
+    WriteInt(levelFile, (Sint32)LEVEL_MAGIC);
+    WriteInt(levelFile, (Sint32)CHUNK_FORMAT_VERSION);
+    const Sint32 values[10] = {info.chunkWidth, info.chunkCount, info.width, info.height,
+                              info.playerStartX, info.playerStartY,
+                              info.goalX, info.goalY, info.goalType, info.timeLimit};
+    for (Sint32 value : values) {
+        WriteInt(levelFile, value);
+    }
+
+    int chunkPixelWidth = info.chunkWidth * TileGrid::TILE_SIZE;
+    for (int index = 0; index < info.chunkCount; index++) {
+        std::ofstream file(ChunkPath(directory, index), std::ios::binary);
+        if (!file) {
+            std::cout << "❌ チャンクを書き込めません: " << ChunkPath(directory, index) << std::endl;
+            return false;
+        }
+        WriteInt(file, (Sint32)CHUNK_MAGIC);
+        WriteInt(file, (Sint32)CHUNK_FORMAT_VERSION);
+        WriteInt(file, index);
+        WriteInt(file, info.chunkWidth);
+        WriteInt(file, info.height);
+
+        // タイル（ステージ外の列は空タイル）
+        int firstColumn = index * info.chunkWidth;
+        for (int y = 0; y < info.height; y++) {
+            for (int x = firstColumn; x < firstColumn + info.chunkWidth; x++) {
+                char tile = (char)tiles.At(x, y);
+                file.write(&tile, 1);
+            }
+        }
+
+        // 敵・アイテムはX座標でチャンクに振り分ける（範囲外は端のチャンク）
+        std::vector<ChunkSpawn> chunkEnemies, chunkItems;
+        for (const ChunkSpawn& spawn : enemies) {
+            int spawnChunk = std::min(std::max(spawn.x / chunkPixelWidth, 0), info.chunkCount - 1);
+            if (spawnChunk == index) chunkEnemies.push_back(spawn);
+        }
+        for (const ChunkSpawn& spawn : items) {
+            int spawnChunk = std::min(std::max(spawn.x / chunkPixelWidth, 0), info.chunkCount - 1);
+            if (spawnChunk == index) chunkItems.push_back(spawn);
+        }
+        WriteSpawns(file, chunkEnemies);
+        WriteSpawns(file, chunkItems);
+    }
+
+    std::cout << "💾 ステージを " << info.chunkCount << " チャンクに書き出しました: " << directory << std::endl;
+    return true;
+}
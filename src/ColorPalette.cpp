@@ -15,6 +15,9 @@ const SDL_Color ColorPalette::PLAYER_GLOW = {180, 200, 255, 100};     // 青い
 const SDL_Color ColorPalette::TILE_MAIN = {60, 70, 85, 255};          // メインの灰青色
 const SDL_Color ColorPalette::TILE_EDGE = {80, 90, 110, 255};         // エッジの明るい色
 const SDL_Color ColorPalette::TILE_SHADOW = {30, 35, 45, 255};        // 影の暗い色
+const SDL_Color ColorPalette::TILE_PLATFORM = {110, 95, 80, 255};     // 古びた木の色
+const SDL_Color ColorPalette::TILE_HAZARD = {190, 200, 215, 255};     // 鈍く光る金属色
+const SDL_Color ColorPalette::TILE_ICE = {150, 210, 240, 255};        // 淡い水色
 
 // UI色（視認性の良い色）
 const SDL_Color ColorPalette::UI_PRIMARY = {200, 210, 230, 255};      // メインUI色
@@ -78,7 +78,7 @@ Enemy::Enemy(int x, int y, EnemyType type)
     }
 }
 
-void Enemy::Update(int playerX, int playerY, int map[19][100]) {
+void Enemy::Update(int playerX, int playerY, const TileGrid& map) {
     if (!active) return;
     
     // プレイヤー位置を保存
@@ -161,7 +161,7 @@ void Enemy::UpdateAI(int playerX, int playerY) {
 }
 
 // 敵の移動更新処理
-void Enemy::UpdateMovement(int map[19][100]) {
+void Enemy::UpdateMovement(const TileGrid& map) {
     // 敵タイプに応じた移動パターン
     switch (type) {
         case ENEMY_GOOMBA:
@@ -231,30 +231,32 @@ void Enemy::UpdateMovement(int map[19][100]) {
     }
     
     // 位置更新
+    int previousY = y;
     x += (int)velX;
     y += (int)velY;
     
     // 簡単な地面判定（詳細な実装は後で）
-    int tileY = (y + rect.h) / 32;
-    if (tileY < 19 && tileY >= 0) {
-        int tileX = (x + rect.w / 2) / 32;
-        if (tileX < 100 && tileX >= 0) {
-            if (map[tileY][tileX] == 1) {
-                y = tileY * 32 - rect.h;
-                velY = 0;
-                isOnGround = true;
-            } else {
-                isOnGround = false;
-            }
+    int tileY = (y + rect.h) / TileGrid::TILE_SIZE;
+    int tileX = (x + rect.w / 2) / TileGrid::TILE_SIZE;
+    if (map.InBounds(tileX, tileY)) {
+        // すり抜け床には、落下中で前の足元が床の上面より上にあった場合のみ着地する
+        bool aboveTile = previousY + rect.h <= tileY * TileGrid::TILE_SIZE;
+        Uint8 landFlags = (velY >= 0 && aboveTile) ? TILE_PROP_STANDABLE : TILE_PROP_SOLID;
+        if (map.Has(tileX, tileY, landFlags)) {
+            y = tileY * TileGrid::TILE_SIZE - rect.h;
+            velY = 0;
+            isOnGround = true;
+        } else {
+            isOnGround = false;
         }
     }
     
-    // 画面境界チェック
+    // 画面境界チェック（ワールドの幅はマップから求める）
     if (x < 0) {
         x = 0;
         direction = 1;
-    } else if (x > 100 * 32 - rect.w) {
-        x = 100 * 32 - rect.w;
+    } else if (x > map.PixelWidth() - rect.w) {
+        x = map.PixelWidth() - rect.w;
         direction = -1;
     }
 }
@@ -346,7 +348,7 @@ float Enemy::DistanceToPlayer(int playerX, int playerY) {
 }
 
 // プレイヤーが見えるかチェック（簡易版）
-bool Enemy::CanSeePlayer(int playerX, int playerY, int map[19][100]) {
+bool Enemy::CanSeePlayer(int playerX, int playerY, const TileGrid* map) {
     // 簡単な実装：距離のみチェック
     return DistanceToPlayer(playerX, playerY) < detectionRange;
 } 
\ No newline at end of file
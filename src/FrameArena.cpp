@@ -0,0 +1,84 @@
+#include "FrameArena.h"
+#include <iostream>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdint>
+
+// 静的メンバの定義
+const size_t FrameArena::DEFAULT_CAPACITY;
+const size_t FrameArena::DEFAULT_ALIGNMENT;
+
+FrameArena::FrameArena(size_t capacity)
+    : buffer(new char[capacity]), capacity(capacity), used(0), overflowBytes(0),
+      overflowBlocks(nullptr), overflowCount(0) {
+}
+
+FrameArena::~FrameArena() {
+    Reset();
+    delete[] buffer;
+}
+
+// size バイトを確保する
+void* FrameArena::Allocate(size_t size, size_t alignment) {
+    // バッファの先頭からの位置ではなくアドレスそのものを揃える
+    uintptr_t base = (uintptr_t)buffer;
+    size_t offset = (size_t)(((base + used + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base);
+    if (offset + size <= capacity) {
+        used = offset + size;
+        return buffer + offset;
+    }
+
+    // 容量が足りない: ヒープから確保する（ブロックの先頭に連結用のヘッダを置く）
+    size_t header = (sizeof(OverflowBlock) + alignment - 1) & ~(alignment - 1);
+    char* block = new char[header + size + alignment];
+    OverflowBlock* overflow = (OverflowBlock*)block;
+    overflow->next = overflowBlocks;
+    overflowBlocks = overflow;
+    overflowBytes += size + alignment;
+    overflowCount++;
+    uintptr_t data = ((uintptr_t)block + header + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    return (void*)data;
+}
+
+// printf 形式で文字列を作る
+const char* FrameArena::Format(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    va_list sizeArgs;
+    va_copy(sizeArgs, args);
+    int length = vsnprintf(nullptr, 0, format, sizeArgs);
+    va_end(sizeArgs);
+    if (length < 0) {
+        va_end(args);
+        return "";
+    }
+
+    char* text = (char*)Allocate(length + 1, 1);
+    vsnprintf(text, length + 1, format, args);
+    va_end(args);
+    return text;
+}
+
+// フレームの始め: 前のフレームの確保をすべて捨てる
+void FrameArena::Reset() {
+    // 前のフレームで容量が足りなかった場合は、そのフレームに必要だった分まで広げる
+    if (overflowBlocks) {
+        size_t required = used + overflowBytes;
+        // 容量0で作った場合は必要な分から始める（0のままでは倍にしても増えない）
+        size_t newCapacity = capacity > 0 ? capacity : required;
+        while (newCapacity < required) newCapacity *= 2;
+        while (overflowBlocks) {
+            OverflowBlock* next = overflowBlocks->next;
+            delete[] (char*)overflowBlocks;
+            overflowBlocks = next;
+        }
+        if (newCapacity != capacity) {
+            delete[] buffer;
+            buffer = new char[newCapacity];
+            capacity = newCapacity;
+            std::cout << "🧮 フレームアリーナの容量を拡張: " << capacity / 1024 << "KB" << std::endl;
+        }
+    }
+    used = 0;
+    overflowBytes = 0;
+}
@@ -0,0 +1,204 @@
+#include "InputBuffer.h"
+#include "LatencyTracker.h"
+#include <cstring>
+
+// 静的メンバの定義
+const int InputBuffer::CAPACITY;
+const int InputBuffer::DEFAULT_BUFFER_TICKS;
+
+// 操作の割り当て（キーボード）
+struct KeyBinding {
+    SDL_Scancode key;
+    InputAction action;
+};
+static const KeyBinding KEY_BINDINGS[] = {
+    {SDL_SCANCODE_LEFT, INPUT_ACTION_LEFT},
+    {SDL_SCANCODE_A, INPUT_ACTION_LEFT},
+    {SDL_SCANCODE_RIGHT, INPUT_ACTION_RIGHT},
+    {SDL_SCANCODE_D, INPUT_ACTION_RIGHT},
+    {SDL_SCANCODE_UP, INPUT_ACTION_UP},
+    {SDL_SCANCODE_W, INPUT_ACTION_UP},
+    {SDL_SCANCODE_DOWN, INPUT_ACTION_DOWN},
+    {SDL_SCANCODE_S, INPUT_ACTION_DOWN},
+    {SDL_SCANCODE_SPACE, INPUT_ACTION_JUMP},
+    {SDL_SCANCODE_W, INPUT_ACTION_JUMP},
+    {SDL_SCANCODE_X, INPUT_ACTION_DASH},
+    {SDL_SCANCODE_LSHIFT, INPUT_ACTION_DASH},
+    {SDL_SCANCODE_Z, INPUT_ACTION_ATTACK},
+    {SDL_SCANCODE_Y, INPUT_ACTION_BEAM},
+    {SDL_SCANCODE_C, INPUT_ACTION_HEAL},
+    {SDL_SCANCODE_N, INPUT_ACTION_NEXT_STAGE},
+    {SDL_SCANCODE_R, INPUT_ACTION_RESTART},
+    {SDL_SCANCODE_RETURN, INPUT_ACTION_CONFIRM},
+    {SDL_SCANCODE_SPACE, INPUT_ACTION_CONFIRM},
+    {SDL_SCANCODE_F3, INPUT_ACTION_PERF_OVERLAY},
+};
+
+// 操作の割り当て（コントローラー）
+struct ButtonBinding {
+    SDL_GameControllerButton button;
+    InputAction action;
+};
+static const ButtonBinding BUTTON_BINDINGS[] = {
+    {SDL_CONTROLLER_BUTTON_DPAD_LEFT, INPUT_ACTION_LEFT},
+    {SDL_CONTROLLER_BUTTON_DPAD_RIGHT, INPUT_ACTION_RIGHT},
+    {SDL_CONTROLLER_BUTTON_DPAD_UP, INPUT_ACTION_UP},
+    {SDL_CONTROLLER_BUTTON_DPAD_DOWN, INPUT_ACTION_DOWN},
+    {SDL_CONTROLLER_BUTTON_A, INPUT_ACTION_JUMP},
+    {SDL_CONTROLLER_BUTTON_X, INPUT_ACTION_DASH},
+    {SDL_CONTROLLER_BUTTON_Y, INPUT_ACTION_ATTACK},
+    {SDL_CONTROLLER_BUTTON_Y, INPUT_ACTION_BEAM},
+    {SDL_CONTROLLER_BUTTON_B, INPUT_ACTION_HEAL},
+    {SDL_CONTROLLER_BUTTON_START, INPUT_ACTION_NEXT_STAGE},
+    {SDL_CONTROLLER_BUTTON_BACK, INPUT_ACTION_RESTART},
+    {SDL_CONTROLLER_BUTTON_A, INPUT_ACTION_CONFIRM},
+};
+
+// 押下を保持する（バッファする）操作
+static const InputActionBits BUFFERED_ACTIONS =
+    ActionBit(INPUT_ACTION_JUMP) | ActionBit(INPUT_ACTION_DASH) | ActionBit(INPUT_ACTION_ATTACK);
+
+InputBuffer::InputBuffer() : bufferTicks(DEFAULT_BUFFER_TICKS) {
+    // 割り当て表をキー・ボタンごとのビットに展開しておく（ティックごとの変換は表引きだけにする）
+    memset(keyActions, 0, sizeof(keyActions));
+    memset(buttonActions, 0, sizeof(buttonActions));
+    for (const KeyBinding& binding : KEY_BINDINGS) {
+        keyActions[binding.key] |= ActionBit(binding.action);
+    }
+    for (const ButtonBinding& binding : BUTTON_BINDINGS) {
+        buttonActions[binding.button] |= ActionBit(binding.action);
+    }
+    Reset();
+}
+
+// イベントを記録
+void InputBuffer::Record(const SDL_Event& event) {
+    InputEvent recorded;
+    switch (event.type) {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            if (event.key.repeat) return;  // 押しっぱなしのリピートは押下として数えない
+            if (event.key.keysym.scancode >= SDL_NUM_SCANCODES) return;
+            recorded = {event.key.timestamp, (Uint16)event.key.keysym.scancode, 0,
+                        (Uint8)(event.type == SDL_KEYDOWN), 0};
+            break;
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP:
+            if (event.cbutton.button >= SDL_CONTROLLER_BUTTON_MAX) return;
+            recorded = {event.cbutton.timestamp, (Uint16)event.cbutton.button, 1,
+                        (Uint8)(event.type == SDL_CONTROLLERBUTTONDOWN), 0};
+            break;
+        default:
+            return;
+    }
+    // 押下には到着時刻のタグを付け、処理したティックと表示されたフレームまで追跡する
+    if (recorded.down && LatencyTracker::IsEnabled()) {
+        recorded.latencyTag = LatencyTracker::Arrive(recorded.timestamp);
+    }
+
+    if (count == CAPACITY) {
+        // あふれた場合は最も古いイベントをすぐに反映してから捨てる（押下状態は正しく保つ）
+        Apply(events[head]);
+        head = (head + 1) % CAPACITY;
+        count--;
+        droppedEvents++;
+    }
+    events[(head + count) % CAPACITY] = recorded;
+    count++;
+}
+
+// ティックの開始: 時刻 time までのイベントを取り出し、このティックの操作を返す
+ActionFrame InputBuffer::BeginTick(Uint32 time, InputActionBits axisActions) {
+    // イベントはタイムスタンプ順に届くので、先頭から time 以下のものを取り出す
+    // （前のティックの後であふれて反映済みの押下も pressedActions に残っている）
+    while (count > 0 && (Sint32)(events[head].timestamp - time) <= 0) {
+        Apply(events[head]);
+        head = (head + 1) % CAPACITY;
+        count--;
+    }
+
+    ActionFrame frame;
+    frame.held = HeldActions() | axisActions;
+    // スティックは倒した瞬間を押下とする
+    frame.pressed = pressedActions | (axisActions & ~previousAxis);
+    previousAxis = axisActions;
+    pressedActions = 0;
+    return frame;
+}
+
+// このティックの操作を確定し、バッファする操作の押下を積む
+void InputBuffer::BufferActions(const ActionFrame& frame) {
+    for (int i = 0; i < INPUT_ACTION_COUNT; i++) {
+        if (frame.pressed & BUFFERED_ACTIONS & ActionBit((InputAction)i)) {
+            pendingTicks[i] = bufferTicks;
+        } else if (pendingTicks[i] > 0) {
+            // 窓を過ぎたアクションの押下は捨てる
+            pendingTicks[i]--;
+        }
+    }
+}
+
+// バッファされたアクションを捨てる（画面の切り替え時など）
+void InputBuffer::ClearActions() {
+    for (int i = 0; i < INPUT_ACTION_COUNT; i++) {
+        pendingTicks[i] = 0;
+    }
+}
+
+// コントローラーのボタンをすべて離した状態にする（切断時）
+void InputBuffer::ReleaseButtons() {
+    for (bool& button : buttons) button = false;
+}
+
+// すべて離した状態に戻す
+void InputBuffer::Reset() {
+    head = 0;
+    count = 0;
+    droppedEvents = 0;
+    memset(keys, 0, sizeof(keys));
+    for (bool& button : buttons) button = false;
+    pressedActions = 0;
+    previousAxis = 0;
+    ClearActions();
+}
+
+// アクションを消費する（押下が無ければ false）
+bool InputBuffer::ConsumeAction(InputAction action) {
+    if (pendingTicks[action] <= 0) return false;
+    pendingTicks[action] = 0;
+    return true;
+}
+
+// 取り出したイベントを押下状態に反映する
+void InputBuffer::Apply(const InputEvent& event) {
+    if (event.latencyTag) LatencyTracker::Consume(event.latencyTag);
+    if (event.isButton) {
+        buttons[event.code] = event.down != 0;
+        if (!event.down) return;
+        pressedActions |= buttonActions[event.code] | ActionBit(INPUT_ACTION_ANY);
+    } else {
+        keys[event.code] = event.down;
+        if (!event.down) return;
+        pressedActions |= keyActions[event.code] | ActionBit(INPUT_ACTION_ANY);
+    }
+}
+
+// 押されているキー・ボタンに割り当てた操作
+InputActionBits InputBuffer::HeldActions() const {
+    InputActionBits held = 0;
+    bool any = false;
+    for (int i = 0; i < SDL_NUM_SCANCODES; i++) {
+        if (keys[i]) {
+            held |= keyActions[i];
+            any = true;
+        }
+    }
+    for (int i = 0; i < SDL_CONTROLLER_BUTTON_MAX; i++) {
+        if (buttons[i]) {
+            held |= buttonActions[i];
+            any = true;
+        }
+    }
+    if (any) held |= ActionBit(INPUT_ACTION_ANY);
+    return held;
+}
@@ -0,0 +1,96 @@
+#include "InputRecorder.h"
+#include <iostream>
+
+namespace {
+
+// ファイルの識別子とバージョン
+const Uint32 RECORD_MAGIC = 0x52504E49;  // "INPR"
+const Uint32 RECORD_FORMAT_VERSION = 1;
+
+void WriteUint(std::ofstream& file, Uint32 value) {
+    file.write((const char*)&value, sizeof(value));
+}
+
+bool ReadUint(std::ifstream& file, Uint32& value) {
+    return (bool)file.read((char*)&value, sizeof(value));
+}
+
+}  // namespace
+
+InputRecorder::InputRecorder() : recording(false), replaying(false), tickCount(0) {
+}
+
+InputRecorder::~InputRecorder() {
+    Stop();
+}
+
+// 記録を開始
+bool InputRecorder::StartRecording(const std::string& path, Uint32 seed) {
+    Stop();
+    output.open(path, std::ios::binary | std::ios::trunc);
+    if (!output) {
+        std::cout << "❌ 入力の記録ファイルを作成できません: " << path << std::endl;
+        return false;
+    }
+    WriteUint(output, RECORD_MAGIC);
+    WriteUint(output, RECORD_FORMAT_VERSION);
+    WriteUint(output, seed);
+    recording = true;
+    tickCount = 0;
+    std::cout << "⏺️ 入力の記録を開始: " << path << std::endl;
+    return true;
+}
+
+// 再生を開始
+bool InputRecorder::StartReplay(const std::string& path, Uint32& seed) {
+    Stop();
+    input.open(path, std::ios::binary);
+    Uint32 magic = 0, version = 0;
+    if (!input || !ReadUint(input, magic) || !ReadUint(input, version) || !ReadUint(input, seed) ||
+        magic != RECORD_MAGIC || version != RECORD_FORMAT_VERSION) {
+        std::cout << "❌ 入力の記録ファイルを読み込めません: " << path << std::endl;
+        input.close();
+        return false;
+    }
+    replaying = true;
+    tickCount = 0;
+    std::cout << "▶️ 入力の再生を開始: " << path << std::endl;
+    return true;
+}
+
+// 記録・再生を終了
+void InputRecorder::Stop() {
+    if (recording) {
+        output.close();
+        recording = false;
+        std::cout << "⏹️ 入力の記録を終了（" << tickCount << "ティック）" << std::endl;
+    }
+    if (replaying) {
+        input.close();
+        replaying = false;
+        std::cout << "⏹️ 入力の再生を終了（" << tickCount << "ティック）" << std::endl;
+    }
+}
+
+// 1ティック分の操作を記録する
+void InputRecorder::Record(const ActionFrame& frame) {
+    if (!recording) return;
+    WriteUint(output, frame.held);
+    WriteUint(output, frame.pressed);
+    tickCount++;
+}
+
+// 1ティック分の操作を読み出す
+bool InputRecorder::Replay(ActionFrame& frame) {
+    if (!replaying) return false;
+    Uint32 held, pressed;
+    if (!ReadUint(input, held) || !ReadUint(input, pressed)) {
+        // 記録の終わり: ここからは実際の入力で操作する
+        Stop();
+        return false;
+    }
+    frame.held = held;
+    frame.pressed = pressed;
+    tickCount++;
+    return true;
+}
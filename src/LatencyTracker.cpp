@@ -0,0 +1,134 @@
+#include "LatencyTracker.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+// 静的メンバの定義
+const int LatencyTracker::MAX_IN_FLIGHT;
+bool LatencyTracker::enabled = false;
+Uint32 LatencyTracker::nextTag = 1;
+LatencyTracker::Sample LatencyTracker::inFlight[MAX_IN_FLIGHT];
+int LatencyTracker::droppedSamples = 0;
+std::vector<double> LatencyTracker::queueTimes;
+std::vector<double> LatencyTracker::simulationTimes;
+std::vector<double> LatencyTracker::renderTimes;
+std::vector<double> LatencyTracker::presentTimes;
+std::vector<double> LatencyTracker::totalTimes;
+
+// 計測の有効化・無効化（有効にした時点から集計し直す）
+void LatencyTracker::SetEnabled(bool enable) {
+    enabled = enable;
+    nextTag = 1;
+    droppedSamples = 0;
+    for (Sample& sample : inFlight) sample.tag = 0;
+    queueTimes.clear();
+    simulationTimes.clear();
+    renderTimes.clear();
+    presentTimes.clear();
+    totalTimes.clear();
+}
+
+// 押下が届いた
+Uint32 LatencyTracker::Arrive(Uint32 timestamp) {
+    if (!enabled) return 0;
+
+    // SDL のタイムスタンプ（ミリ秒）は OS がイベントを受け取った時刻なので、
+    // 経過したミリ秒だけ現在のパフォーマンスカウンタから戻して到着時刻にする
+    Uint64 now = SDL_GetPerformanceCounter();
+    Sint32 age = (Sint32)(SDL_GetTicks() - timestamp);
+    Uint64 ageTicks = age > 0 ? (Uint64)age * SDL_GetPerformanceFrequency() / 1000 : 0;
+
+    Uint32 tag = nextTag++;
+    if (nextTag == 0) nextTag = 1;  // 0 は「追跡しない」
+    Sample& sample = inFlight[tag % MAX_IN_FLIGHT];
+    if (sample.tag != 0) droppedSamples++;  // 表示まで届かなかった古い押下を上書きする
+    sample = {tag, ageTicks < now ? now - ageTicks : now, 0, 0, 0};
+    return tag;
+}
+
+// タグの付いた押下をティックで処理した
+void LatencyTracker::Consume(Uint32 tag) {
+    if (!enabled || tag == 0) return;
+    Sample& sample = inFlight[tag % MAX_IN_FLIGHT];
+    // 上書きされた古いタグは無視する
+    if (sample.tag != tag || sample.consumed != 0) return;
+    sample.consumed = SDL_GetPerformanceCounter();
+}
+
+// 描画の開始: 処理済みの押下はこのフレームで初めて画面に反映される
+void LatencyTracker::BeginRender() {
+    if (!enabled) return;
+    Uint64 now = SDL_GetPerformanceCounter();
+    for (Sample& sample : inFlight) {
+        if (sample.tag != 0 && sample.consumed != 0 && sample.renderStart == 0) {
+            sample.renderStart = now;
+        }
+    }
+}
+
+// SDL_RenderPresent の呼び出し
+void LatencyTracker::BeginPresent() {
+    if (!enabled) return;
+    Uint64 now = SDL_GetPerformanceCounter();
+    for (Sample& sample : inFlight) {
+        if (sample.tag != 0 && sample.renderStart != 0 && sample.presentStart == 0) {
+            sample.presentStart = now;
+        }
+    }
+}
+
+// SDL_RenderPresent から戻った: このフレームで表示した押下の内訳を記録する
+void LatencyTracker::EndPresent() {
+    if (!enabled) return;
+    Uint64 now = SDL_GetPerformanceCounter();
+    for (Sample& sample : inFlight) {
+        if (sample.tag == 0 || sample.presentStart == 0) continue;
+        queueTimes.push_back(ToMilliseconds(sample.consumed - sample.arrival));
+        simulationTimes.push_back(ToMilliseconds(sample.renderStart - sample.consumed));
+        renderTimes.push_back(ToMilliseconds(sample.presentStart - sample.renderStart));
+        presentTimes.push_back(ToMilliseconds(now - sample.presentStart));
+        totalTimes.push_back(ToMilliseconds(now - sample.arrival));
+        sample.tag = 0;
+    }
+}
+
+double LatencyTracker::ToMilliseconds(Uint64 ticks) {
+    return ticks * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+// 1つの内訳の分布を出力（値は並べ替えるのでコピーを受け取る）
+void LatencyTracker::PrintDistribution(const char* name, std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    double sum = 0.0;
+    for (double value : values) sum += value;
+    size_t last = values.size() - 1;
+    std::cout << "  " << std::left << std::setw(14) << name
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(9) << sum / values.size()
+              << std::setw(9) << values[last * 50 / 100]
+              << std::setw(9) << values[last * 95 / 100]
+              << std::setw(9) << values[last * 99 / 100]
+              << std::setw(9) << values[last] << std::endl;
+}
+
+// 集計結果をコンソールに出力
+void LatencyTracker::PrintReport() {
+    if (!enabled) return;
+
+    std::cout << "⏱️ 入力遅延（押下 → 表示, " << totalTimes.size() << " 回, 追跡できなかった押下 "
+              << droppedSamples << "）" << std::endl;
+    if (totalTimes.empty()) return;
+
+    std::cout << "  " << std::left << std::setw(14) << "ms"
+              << std::right << std::setw(9) << "avg"
+              << std::setw(9) << "p50"
+              << std::setw(9) << "p95"
+              << std::setw(9) << "p99"
+              << std::setw(9) << "max" << std::endl;
+    PrintDistribution("queue", queueTimes);
+    PrintDistribution("simulation", simulationTimes);
+    PrintDistribution("render", renderTimes);
+    PrintDistribution("present", presentTimes);
+    PrintDistribution("total", totalTimes);
+    std::cout.unsetf(std::ios::fixed);
+}
@@ -0,0 +1,264 @@
+#include "LevelStreamer.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+// 静的メンバ定数の定義（std::minに参照で渡すため）
+const int LevelStreamer::WINDOW_CHUNKS;
+
+// コンストラクタ
+LevelStreamer::LevelStreamer(ChunkSource* source)
+    : source(source), info(), chunkPixelWidth(1),
+      firstChunk(-1), lastViewX(0), travelDirection(1), syncLoads(0),
+      stopping(false) {
+}
+
+// デストラクタ: 読み込みスレッドを停止し、チャンクを解放
+LevelStreamer::~LevelStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    requestCondition.notify_all();
+    if (loader.joinable()) {
+        loader.join();
+    }
+
+    for (auto& entry : ready) {
+        delete entry.second;
+    }
+    for (LevelChunk* chunk : resident) {
+        delete chunk;
+    }
+    delete source;
+}
+
+// ステージ情報を読み込み、読み込みスレッドを起動
+bool LevelStreamer::Open() {
+    if (!source || !source->ReadInfo(info)) {
+        return false;
+    }
+    chunkPixelWidth = info.chunkWidth * TileGrid::TILE_SIZE;
+    loader = std::thread(&LevelStreamer::LoaderLoop, this);
+
+    std::cout << "🗺️ ストリーミングステージ: " << info.chunkCount << " チャンク (1チャンク "
+              << info.chunkWidth << " タイル, 全長 " << info.width << " タイル)" << std::endl;
+    return true;
+}
+
+// X座標からチャンク番号を求める（範囲外は端のチャンク）
+int LevelStreamer::ChunkAt(int worldX) const {
+    int chunk = worldX >= 0 ? worldX / chunkPixelWidth : -1;
+    return std::min(std::max(chunk, 0), info.chunkCount - 1);
+}
+
+// 表示範囲に対して望ましいウィンドウ先頭を計算
+// 進行方向の側に多くのチャンクを残し、後方は1チャンクだけ保持する
+int LevelStreamer::ChooseFirstChunk(const SDL_Rect& view) const {
+    int windowCount = std::min(WINDOW_CHUNKS, info.chunkCount);
+    int first;
+    if (travelDirection >= 0) {
+        first = ChunkAt(view.x) - 1;
+    } else {
+        first = ChunkAt(view.x + view.w - 1) + 1 - (windowCount - 1);
+    }
+    return std::min(std::max(first, 0), info.chunkCount - windowCount);
+}
+
+// カメラの表示範囲に合わせてウィンドウを更新
+bool LevelStreamer::Update(const SDL_Rect& view, TileGrid& map, std::vector<Enemy>& enemies, std::vector<Item>& items) {
+    // 進行方向の判定（止まっている間は直前の方向を維持）
+    if (view.x > lastViewX) {
+        travelDirection = 1;
+    } else if (view.x < lastViewX) {
+        travelDirection = -1;
+    }
+    lastViewX = view.x;
+
+    int windowCount = std::min(WINDOW_CHUNKS, info.chunkCount);
+    int newFirst = firstChunk;
+    if (firstChunk < 0) {
+        newFirst = ChooseFirstChunk(view);
+    } else {
+        // 表示範囲 + 半チャンクの余裕がウィンドウに収まっている間は動かさない（往復時のばたつき防止）
+        int margin = chunkPixelWidth / 2;
+        bool leftCovered = firstChunk == 0 || view.x - margin >= firstChunk * chunkPixelWidth;
+        bool rightCovered = firstChunk + windowCount >= info.chunkCount ||
+                            view.x + view.w + margin <= (firstChunk + windowCount) * chunkPixelWidth;
+        if (!leftCovered || !rightCovered) {
+            newFirst = ChooseFirstChunk(view);
+        }
+    }
+
+    // 進行方向の先にある次のチャンクを先読み
+    int ahead = travelDirection > 0 ? newFirst + windowCount : newFirst - 1;
+    if (ahead >= 0 && ahead < info.chunkCount) {
+        RequestChunk(ahead);
+    }
+
+    if (newFirst == firstChunk) {
+        return false;
+    }
+
+    // === 常駐チャンクの入れ替え（ウィンドウに残るものは再利用） ===
+    std::vector<LevelChunk*> newResident(windowCount, nullptr);
+    for (LevelChunk* chunk : resident) {
+        int slot = chunk->index - newFirst;
+        if (slot >= 0 && slot < windowCount) {
+            newResident[slot] = chunk;
+        } else {
+            delete chunk;
+        }
+    }
+
+    // === ウィンドウ外に出た敵・アイテムの状態を、いる位置のチャンクに保存 ===
+    std::vector<Enemy> keptEnemies;
+    keptEnemies.reserve(enemies.size());
+    for (const Enemy& enemy : enemies) {
+        int chunk = ChunkAt(enemy.x + enemy.rect.w / 2);
+        if (chunk < newFirst || chunk >= newFirst + windowCount) {
+            savedStates[chunk].enemies.push_back(enemy);
+        } else {
+            keptEnemies.push_back(enemy);
+        }
+    }
+    enemies.swap(keptEnemies);
+
+    std::vector<Item> keptItems;
+    keptItems.reserve(items.size());
+    for (const Item& item : items) {
+        int chunk = ChunkAt(item.x + item.rect.w / 2);
+        if (chunk < newFirst || chunk >= newFirst + windowCount) {
+            savedStates[chunk].items.push_back(item);
+        } else {
+            keptItems.push_back(item);
+        }
+    }
+    items.swap(keptItems);
+
+    // === 新しく入ったチャンクを取得し、敵・アイテムを配置（保存済みの状態があれば復元） ===
+    for (int slot = 0; slot < windowCount; slot++) {
+        if (newResident[slot]) continue;
+        int index = newFirst + slot;
+        LevelChunk* chunk = AcquireChunk(index);
+        newResident[slot] = chunk;
+
+        if (spawnedChunks.insert(index).second) {
+            for (const ChunkSpawn& spawn : chunk->enemies) {
+                enemies.push_back(Enemy(spawn.x, spawn.y, (EnemyType)spawn.type));
+            }
+            for (const ChunkSpawn& spawn : chunk->items) {
+                items.push_back(Item(spawn.x, spawn.y, (ItemType)spawn.type));
+            }
+        }
+
+        auto saved = savedStates.find(index);
+        if (saved != savedStates.end()) {
+            enemies.insert(enemies.end(), saved->second.enemies.begin(), saved->second.enemies.end());
+            items.insert(items.end(), saved->second.items.begin(), saved->second.items.end());
+            savedStates.erase(saved);
+        }
+    }
+    resident.swap(newResident);
+    firstChunk = newFirst;
+
+    // === ウィンドウ分のタイルグリッドを作り直す ===
+    map.Resize(windowCount * info.chunkWidth, info.height);
+    map.SetWindow(firstChunk * info.chunkWidth, info.width);
+    for (int slot = 0; slot < windowCount; slot++) {
+        const LevelChunk* chunk = resident[slot];
+        for (int y = 0; y < info.height; y++) {
+            memcpy(map.Row(y) + slot * info.chunkWidth, &chunk->tiles[y * info.chunkWidth], info.chunkWidth);
+        }
+    }
+
+    PruneReady();
+
+    std::cout << "🧩 チャンク " << firstChunk << "-" << (firstChunk + windowCount - 1)
+              << " を常駐 (敵 " << enemies.size() << ", アイテム " << items.size() << ")" << std::endl;
+    return true;
+}
+
+// 先読みを要求
+void LevelStreamer::RequestChunk(int index) {
+    for (const LevelChunk* chunk : resident) {
+        if (chunk->index == index) return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pending.count(index) || ready.count(index)) return;
+        pending.insert(index);
+        requests.push_back(index);
+    }
+    requestCondition.notify_one();
+}
+
+// 先読み済みのチャンクを取り出す
+LevelChunk* LevelStreamer::AcquireChunk(int index) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = ready.find(index);
+        if (it != ready.end()) {
+            LevelChunk* chunk = it->second;
+            ready.erase(it);
+            return chunk;
+        }
+    }
+
+    // 先読みが間に合わなかった場合はこのスレッドで読み込む（初回の読み込みは数えない）
+    if (firstChunk >= 0) {
+        syncLoads++;
+        std::cout << "⚠️ チャンク " << index << " の先読みが間に合わず同期読み込み" << std::endl;
+    }
+    LevelChunk* chunk = new LevelChunk();
+    if (!source->LoadChunk(index, *chunk) || (int)chunk->tiles.size() != info.chunkWidth * info.height) {
+        // 読み込めないチャンクは空のチャンクとして扱う
+        chunk->index = index;
+        chunk->tiles.assign(info.chunkWidth * info.height, TILE_EMPTY);
+        chunk->enemies.clear();
+        chunk->items.clear();
+    }
+    return chunk;
+}
+
+// ウィンドウのすぐ外側以外の先読み済みチャンクを破棄（常駐済みの重複や遠いもの）
+void LevelStreamer::PruneReady() {
+    int windowCount = (int)resident.size();
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = ready.begin(); it != ready.end();) {
+        int index = it->first;
+        if (index == firstChunk - 1 || index == firstChunk + windowCount) {
+            ++it;
+        } else {
+            delete it->second;
+            it = ready.erase(it);
+        }
+    }
+}
+
+// 読み込みスレッドのメインループ
+void LevelStreamer::LoaderLoop() {
+    while (true) {
+        int index;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            requestCondition.wait(lock, [this] { return stopping || !requests.empty(); });
+            if (stopping) return;
+            index = requests.front();
+            requests.pop_front();
+        }
+
+        LevelChunk* chunk = new LevelChunk();
+        bool loaded = source->LoadChunk(index, *chunk) &&
+                      (int)chunk->tiles.size() == info.chunkWidth * info.height;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.erase(index);
+        if (loaded && !stopping && !ready.count(index)) {
+            ready[index] = chunk;
+        } else {
+            delete chunk;
+        }
+    }
+}
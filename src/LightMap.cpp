@@ -0,0 +1,176 @@
+#include "LightMap.h"
+#include "RenderProfiler.h"
+#include <iostream>
+#include <algorithm>
+
+// SSE2が使える環境ではSIMD版の加算を使用（x86-64では常に利用可能）
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LIGHTMAP_SSE2 1
+#endif
+
+namespace {
+
+// ブロック内部に届く光の割合（ブロックは光をほとんど通さない）
+const float OCCLUDED_LIGHT = 0.3f;
+
+} // namespace
+
+// コンストラクタ: 縮小解像度のバッファを確保
+LightMap::LightMap(int screenWidth, int screenHeight, int scale)
+    : screenWidth(screenWidth), screenHeight(screenHeight), scale(scale),
+      width((screenWidth + scale - 1) / scale), height((screenHeight + scale - 1) / scale),
+      ambient(255.0f), lightCount(0),
+      texture(nullptr), textureRenderer(nullptr) {
+    red.assign(width * height, 0.0f);
+    green.assign(width * height, 0.0f);
+    blue.assign(width * height, 0.0f);
+    occlusion.assign(width * height, 0);
+}
+
+// デストラクタ: テクスチャを解放
+LightMap::~LightMap() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+}
+
+// フレームの開始
+void LightMap::Begin(float ambientLevel) {
+    ambient = std::max(0.0f, std::min(1.0f, ambientLevel)) * 255.0f;
+    lightCount = 0;
+    std::fill(red.begin(), red.end(), 0.0f);
+    std::fill(green.begin(), green.end(), 0.0f);
+    std::fill(blue.begin(), blue.end(), 0.0f);
+    std::fill(occlusion.begin(), occlusion.end(), 0);
+}
+
+// 光を遮るブロックを登録
+void LightMap::AddOccluder(const SDL_Rect& screenRect) {
+    // テクセルの中心が矩形内にあるものを遮蔽扱いにする
+    int x0 = std::max(0, (screenRect.x + scale / 2) / scale);
+    int y0 = std::max(0, (screenRect.y + scale / 2) / scale);
+    int x1 = std::min(width, (screenRect.x + screenRect.w + scale / 2) / scale);
+    int y1 = std::min(height, (screenRect.y + screenRect.h + scale / 2) / scale);
+    for (int y = y0; y < y1; y++) {
+        std::fill(occlusion.begin() + y * width + x0, occlusion.begin() + y * width + std::max(x0, x1), 1);
+    }
+}
+
+// 点光源を加算（減衰は (1 - d²/r²)² のなめらかな曲線）
+void LightMap::AddLight(int screenX, int screenY, int radius, SDL_Color color, float intensity) {
+    float lightX = (float)screenX / scale;
+    float lightY = (float)screenY / scale;
+    float lightRadius = std::max(1.0f, (float)radius / scale);
+
+    int x0 = std::max(0, (int)(lightX - lightRadius));
+    int y0 = std::max(0, (int)(lightY - lightRadius));
+    int x1 = std::min(width, (int)(lightX + lightRadius) + 1);
+    int y1 = std::min(height, (int)(lightY + lightRadius) + 1);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    // ブロックの中に埋まっている光源は無視
+    int centerX = (int)lightX;
+    int centerY = (int)lightY;
+    if (centerX >= 0 && centerX < width && centerY >= 0 && centerY < height &&
+        occlusion[centerY * width + centerX]) {
+        return;
+    }
+
+    lightCount++;
+    float invRadiusSq = 1.0f / (lightRadius * lightRadius);
+    float colorR = color.r * intensity;
+    float colorG = color.g * intensity;
+    float colorB = color.b * intensity;
+
+    for (int y = y0; y < y1; y++) {
+        float dy = (y + 0.5f) - lightY;
+        float dySq = dy * dy;
+        float* rowR = &red[y * width];
+        float* rowG = &green[y * width];
+        float* rowB = &blue[y * width];
+        int x = x0;
+#ifdef LIGHTMAP_SSE2
+        // 4テクセルずつ距離と減衰を計算して加算
+        __m128 dx = _mm_sub_ps(_mm_set_ps(x + 3.5f, x + 2.5f, x + 1.5f, x + 0.5f), _mm_set1_ps(lightX));
+        __m128 step = _mm_set1_ps(4.0f);
+        __m128 dyVec = _mm_set1_ps(dySq);
+        __m128 invVec = _mm_set1_ps(invRadiusSq);
+        __m128 one = _mm_set1_ps(1.0f);
+        __m128 zero = _mm_setzero_ps();
+        __m128 vr = _mm_set1_ps(colorR);
+        __m128 vg = _mm_set1_ps(colorG);
+        __m128 vb = _mm_set1_ps(colorB);
+        for (; x + 4 <= x1; x += 4) {
+            __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), dyVec);
+            __m128 falloff = _mm_max_ps(zero, _mm_sub_ps(one, _mm_mul_ps(distSq, invVec)));
+            falloff = _mm_mul_ps(falloff, falloff);
+            _mm_storeu_ps(rowR + x, _mm_add_ps(_mm_loadu_ps(rowR + x), _mm_mul_ps(falloff, vr)));
+            _mm_storeu_ps(rowG + x, _mm_add_ps(_mm_loadu_ps(rowG + x), _mm_mul_ps(falloff, vg)));
+            _mm_storeu_ps(rowB + x, _mm_add_ps(_mm_loadu_ps(rowB + x), _mm_mul_ps(falloff, vb)));
+            dx = _mm_add_ps(dx, step);
+        }
+#endif
+        // 残りのテクセル（またはSIMDが使えない環境）はスカラー版で処理
+        for (; x < x1; x++) {
+            float dx = (x + 0.5f) - lightX;
+            float falloff = 1.0f - (dx * dx + dySq) * invRadiusSq;
+            if (falloff <= 0.0f) continue;
+            falloff *= falloff;
+            rowR[x] += falloff * colorR;
+            rowG[x] += falloff * colorG;
+            rowB[x] += falloff * colorB;
+        }
+    }
+}
+
+// テクスチャの作成
+bool LightMap::EnsureTexture(SDL_Renderer* renderer) {
+    if (texture && textureRenderer == renderer) return true;
+
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, width, height);
+    if (!texture) {
+        std::cout << "⚠️ ライトマップ用テクスチャ作成エラー: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    textureRenderer = renderer;
+
+    // シーンに乗算し、拡大時は線形補間でなめらかにする
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_MOD);
+    SDL_SetTextureScaleMode(texture, SDL_ScaleModeLinear);
+    return true;
+}
+
+// ライトマップを転送して乗算合成
+void LightMap::Render(SDL_Renderer* renderer) {
+    if (!EnsureTexture(renderer)) return;
+
+    void* pixels = nullptr;
+    int pitch = 0;
+    if (SDL_LockTexture(texture, nullptr, &pixels, &pitch) != 0) {
+        return;
+    }
+
+    // 環境光 + 光源（ブロック内部は減衰）を0-255に丸めて書き込む
+    for (int y = 0; y < height; y++) {
+        Uint32* row = (Uint32*)((Uint8*)pixels + y * pitch);
+        for (int x = 0; x < width; x++) {
+            int index = y * width + x;
+            float factor = occlusion[index] ? OCCLUDED_LIGHT : 1.0f;
+            int r = (int)std::min(255.0f, ambient + red[index] * factor);
+            int g = (int)std::min(255.0f, ambient + green[index] * factor);
+            int b = (int)std::min(255.0f, ambient + blue[index] * factor);
+            row[x] = 0xFF000000u | (r << 16) | (g << 8) | b;
+        }
+    }
+    SDL_UnlockTexture(texture);
+
+    SDL_Rect destRect = {0, 0, screenWidth, screenHeight};
+    RenderProfiler::Copy(renderer, texture, nullptr, &destRect);
+}
@@ -0,0 +1,108 @@
+#include "MappedStage.h"
+#include <iostream>
+#include <fstream>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// コンストラクタ
+MappedStage::MappedStage() : data(nullptr), size(0), mapped(false) {
+}
+
+// デストラクタ
+MappedStage::~MappedStage() {
+    Close();
+}
+
+// ファイルをメモリにマップして検証
+bool MappedStage::Open(const std::string& path) {
+    Close();
+
+#ifndef _WIN32
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size < (off_t)sizeof(StageFileHeader)) {
+        close(fd);
+        std::cout << "❌ ステージファイルが不正です: " << path << std::endl;
+        return false;
+    }
+    void* address = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // マップ後はファイルを閉じてもよい
+    if (address == MAP_FAILED) {
+        std::cout << "❌ ステージファイルをマップできません: " << path << std::endl;
+        return false;
+    }
+    data = (const Uint8*)address;
+    size = (size_t)fileStat.st_size;
+    mapped = true;
+#else
+    // mmapが無い環境ではファイル全体を一度に読み込む
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    size = (size_t)file.tellg();
+    if (size < sizeof(StageFileHeader)) {
+        std::cout << "❌ ステージファイルが不正です: " << path << std::endl;
+        size = 0;
+        return false;
+    }
+    Uint8* buffer = new Uint8[size];
+    file.seekg(0);
+    file.read((char*)buffer, size);
+    data = buffer;
+    mapped = false;
+#endif
+
+    if (!Validate()) {
+        std::cout << "❌ ステージファイルの形式が不正です: " << path << std::endl;
+        Close();
+        return false;
+    }
+    this->path = path;
+    return true;
+}
+
+// マップを解除
+void MappedStage::Close() {
+    if (!data) return;
+#ifndef _WIN32
+    if (mapped) {
+        munmap((void*)data, size);
+    }
+#endif
+    if (!mapped) {
+        delete[] data;
+    }
+    data = nullptr;
+    size = 0;
+    mapped = false;
+}
+
+// ヘッダと各セクションの範囲を検証（データの中身は見ない）
+bool MappedStage::Validate() const {
+    const StageFileHeader& header = Header();
+    if (header.magic != STAGE_FILE_MAGIC || header.version != STAGE_FILE_VERSION || header.fileSize != size) {
+        return false;
+    }
+    if (header.width <= 0 || header.height <= 0) {
+        return false;
+    }
+
+    // セクションがファイル内に収まっているか（64bitで計算してオーバーフローを避ける）
+    auto fits = [this](Uint64 offset, Uint64 bytes) { return offset + bytes <= size; };
+    bool aligned = header.enemiesOffset % 4 == 0 && header.itemsOffset % 4 == 0;
+    return aligned &&
+           fits(header.tilesOffset, (Uint64)header.width * header.height) &&
+           fits(header.enemiesOffset, (Uint64)header.enemyCount * sizeof(StageFileSpawn)) &&
+           fits(header.itemsOffset, (Uint64)header.itemCount * sizeof(StageFileSpawn)) &&
+           fits(header.nameOffset, header.nameLength) &&
+           fits(header.bgmOffset, header.bgmLength);
+}
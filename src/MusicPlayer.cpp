@@ -0,0 +1,212 @@
+#ifdef SOUND_ENABLED
+
+#include "MusicPlayer.h"
+#include "StartupProfiler.h"
+#include <iostream>
+#include <chrono>
+
+// 静的メンバの定義
+const int MusicPlayer::FADE_MS;
+const int MusicPlayer::FILL_INTERVAL_MS;
+
+// コンストラクタ: BGMスレッドを起動
+MusicPlayer::MusicPlayer()
+    : stopping(false), stopRequested(false), volumeRequest(-1),
+      current(nullptr), next(nullptr), prefetched(nullptr), fadingOut(false) {
+    worker = std::thread(&MusicPlayer::WorkerLoop, this);
+}
+
+// デストラクタ: BGMスレッドを終了（曲の後始末はスレッドの最後で行う）
+MusicPlayer::~MusicPlayer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    worker.join();
+}
+
+// 曲を切り替える（要求を置くだけ、前の要求は上書きされる）
+void MusicPlayer::Play(const std::string& path, const std::string& fallbackPath) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        playPath = path;
+        playFallbackPath = fallbackPath;
+        stopRequested = false;
+    }
+    condition.notify_one();
+}
+
+// 次に使いそうな曲を先読み
+void MusicPlayer::Prefetch(const std::string& path, const std::string& fallbackPath) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        prefetchPath = path;
+        prefetchFallbackPath = fallbackPath;
+    }
+    condition.notify_one();
+}
+
+// フェードアウトして止める
+void MusicPlayer::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        playPath.clear();
+        stopRequested = true;
+    }
+    condition.notify_one();
+}
+
+// BGMの音量を変える（要求を置くだけ、BGMスレッドで反映する）
+void MusicPlayer::SetVolume(int volume) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        volumeRequest = volume;
+    }
+    condition.notify_one();
+}
+
+// BGMスレッドのメインループ
+void MusicPlayer::WorkerLoop() {
+    while (true) {
+        std::string path, fallbackPath, prefetch, prefetchFallback;
+        bool stop;
+        int volume;
+        {
+            // 要求が来るか、次の先読みの時間まで待つ
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait_for(lock, std::chrono::milliseconds(FILL_INTERVAL_MS), [this] {
+                return stopping || stopRequested || volumeRequest >= 0 || !playPath.empty() || !prefetchPath.empty();
+            });
+            if (stopping) break;
+            path.swap(playPath);
+            fallbackPath.swap(playFallbackPath);
+            prefetch.swap(prefetchPath);
+            prefetchFallback.swap(prefetchFallbackPath);
+            stop = stopRequested;
+            stopRequested = false;
+            volume = volumeRequest;
+            volumeRequest = -1;
+        }
+
+        if (volume >= 0) {
+            Mix_VolumeMusic(volume);
+        }
+
+        if (stop) {
+            // 切り替え待ちの曲は捨てて、再生中の曲をフェードアウト
+            CloseTrack(next);
+            if (current && !fadingOut) {
+                Mix_FadeOutMusic(FADE_MS);
+                fadingOut = true;
+            }
+        }
+        if (!path.empty()) {
+            SwitchTo(path, fallbackPath);
+        }
+        if (!prefetch.empty()) {
+            const Track* target = TargetTrack();
+            bool inUse = (target && target->Matches(prefetch, prefetchFallback)) ||
+                         (prefetched && prefetched->Matches(prefetch, prefetchFallback));
+            if (!inUse) {
+                CloseTrack(prefetched);
+                prefetched = OpenTrack(prefetch, prefetchFallback);
+            }
+        }
+
+        // フェードアウトが終わった曲を閉じて、次の曲をフェードインで始める
+        if (current && !Mix_PlayingMusic()) {
+            CloseTrack(current);
+            fadingOut = false;
+        }
+        if (!current && next) {
+            current = next;
+            next = nullptr;
+            if (Mix_FadeInMusic(current->music, -1, FADE_MS) != 0) {
+                std::cout << "⚠️ BGM再生エラー: " << current->stream->Path() << " (" << Mix_GetError() << ")" << std::endl;
+            }
+        }
+
+        // 先読み（デコーダが読み込む前に窓を補充しておく）
+        if (current) current->stream->Fill();
+        if (next) next->stream->Fill();
+    }
+
+    // 後始末: 再生を止めてからすべての曲を閉じる
+    Mix_HaltMusic();
+    CloseTrack(current);
+    CloseTrack(next);
+    CloseTrack(prefetched);
+}
+
+// 要求された曲に切り替える
+void MusicPlayer::SwitchTo(const std::string& path, const std::string& fallbackPath) {
+    // 同じ曲が再生中・切り替え待ちならそのまま続ける（ステージのやり直しなど）
+    // （代わりのファイルを開いた曲も、要求されたパスの組が同じなら同じ曲として扱う）
+    const Track* target = TargetTrack();
+    if (target && target->Matches(path, fallbackPath)) return;
+
+    Track* track = OpenTrack(path, fallbackPath);
+    if (!track) return;
+
+    CloseTrack(next);
+    next = track;
+    if (current && !fadingOut) {
+        Mix_FadeOutMusic(FADE_MS);
+        fadingOut = true;
+    }
+}
+
+// 曲を開く（先読み済みならそれを使う）
+MusicPlayer::Track* MusicPlayer::OpenTrack(const std::string& path, const std::string& fallbackPath) {
+    if (prefetched && prefetched->Matches(path, fallbackPath)) {
+        Track* track = prefetched;
+        prefetched = nullptr;
+        return track;
+    }
+
+    Track* track = OpenFile(path);
+    if (!track && !fallbackPath.empty()) {
+        track = OpenFile(fallbackPath);
+    }
+    if (!track) return nullptr;
+    track->path = path;
+    track->fallbackPath = fallbackPath;
+    return track;
+}
+
+// ファイルを1つ開く（最初の窓を読み込み、デコーダを作る）
+MusicPlayer::Track* MusicPlayer::OpenFile(const std::string& path) {
+    StartupPhase phase("music open");  // 起動中のみ記録される
+    MusicStream* stream = new MusicStream();
+    if (!stream->Open(path)) {
+        std::cout << "⚠️ BGMファイルを開けません: " << path << std::endl;
+        delete stream;
+        return nullptr;
+    }
+    Mix_Music* music = Mix_LoadMUS_RW(stream->RWops(), 0);
+    if (!music) {
+        std::cout << "⚠️ BGM読み込みエラー: " << path << " (" << Mix_GetError() << ")" << std::endl;
+        delete stream;
+        return nullptr;
+    }
+    return new Track{stream, music, path, ""};
+}
+
+// 曲を閉じる（デコーダを先に解放してからストリームを閉じる）
+void MusicPlayer::CloseTrack(Track*& track) {
+    if (!track) return;
+    Mix_FreeMusic(track->music);
+    delete track->stream;
+    delete track;
+    track = nullptr;
+}
+
+// 曲の切り替え先として最後に決まっている曲
+const MusicPlayer::Track* MusicPlayer::TargetTrack() const {
+    if (next) return next;
+    if (current && !fadingOut) return current;
+    return nullptr;
+}
+
+#endif  // SOUND_ENABLED
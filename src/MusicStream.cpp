@@ -0,0 +1,190 @@
+#ifdef SOUND_ENABLED
+
+#include "MusicStream.h"
+#include <cstring>
+#include <algorithm>
+
+// 静的メンバの定義
+const int MusicStream::WINDOW_SIZE;
+const int MusicStream::HISTORY_SIZE;
+
+MusicStream::MusicStream()
+    : file(nullptr), fileSize(0), filePosition(0), rw(nullptr),
+      windowStart(0), windowFill(0), readPosition(0), underruns(0) {}
+
+// デストラクタ: ファイルと SDL_RWops を閉じる
+MusicStream::~MusicStream() {
+    if (rw) {
+        SDL_FreeRW(rw);
+        rw = nullptr;
+    }
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+// ファイルを開いて最初の窓を読み込む
+bool MusicStream::Open(const std::string& filePath) {
+    path = filePath;
+    file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    fseek(file, 0, SEEK_END);
+    fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    filePosition = 0;
+
+    window.resize(WINDOW_SIZE);
+    scratch.resize(WINDOW_SIZE);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        FillLocked();
+    }
+
+    rw = SDL_AllocRW();
+    if (!rw) return false;
+    rw->size = &MusicStream::SizeCallback;
+    rw->seek = &MusicStream::SeekCallback;
+    rw->read = &MusicStream::ReadCallback;
+    rw->write = &MusicStream::WriteCallback;
+    rw->close = &MusicStream::CloseCallback;
+    rw->hidden.unknown.data1 = this;
+    return true;
+}
+
+// 先読み（再生位置より先が窓の半分を切っていたら補充）
+// ファイルの読み込みは mutex の外で行い、デコーダがディスクの読み込みを待たないようにする
+void MusicStream::Fill() {
+    Sint64 end;
+    size_t space;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!file) return;
+        Sint64 windowEnd = windowStart + (Sint64)windowFill;
+        bool inside = readPosition >= windowStart && readPosition <= windowEnd;
+        if (inside && (windowEnd - readPosition >= WINDOW_SIZE / 2 || windowEnd >= fileSize)) return;
+        CompactLocked();
+        end = windowStart + (Sint64)windowFill;
+        if (end >= fileSize || windowFill >= window.size()) return;
+        space = window.size() - windowFill;
+    }
+
+    size_t bytes;
+    {
+        std::lock_guard<std::mutex> fileLock(fileMutex);
+        bytes = ReadFile(end, scratch.data(), space);
+    }
+
+    // 読んでいる間に再生位置が進んでいれば詰め直してから、窓の続きに書き込む
+    std::lock_guard<std::mutex> lock(mutex);
+    CompactLocked();
+    // 読んでいる間にシーク・デコーダ側での補充があって窓の終わりが変わっていたら捨てる
+    if (windowStart + (Sint64)windowFill != end) return;
+    bytes = std::min(bytes, window.size() - windowFill);
+    memcpy(window.data() + windowFill, scratch.data(), bytes);
+    windowFill += bytes;
+}
+
+// 先読みが間に合わなかった回数
+int MusicStream::Underruns() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return underruns;
+}
+
+// 再生位置に合わせて窓を詰めて、ファイルの続きを読み込む
+void MusicStream::FillLocked() {
+    CompactLocked();
+    Sint64 end = windowStart + (Sint64)windowFill;
+    if (end >= fileSize || windowFill >= window.size()) return;
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+    windowFill += ReadFile(end, window.data() + windowFill, window.size() - windowFill);
+}
+
+// 読み終わった部分を前に詰める（窓の外にシークしていたら窓を作り直す）
+void MusicStream::CompactLocked() {
+    if (readPosition < windowStart || readPosition > windowStart + (Sint64)windowFill) {
+        // 窓の外にシークした: その位置から窓を作り直す
+        windowStart = readPosition;
+        windowFill = 0;
+    } else {
+        // 読み終わった部分を（少しだけ残して）前に詰める
+        Sint64 discard = readPosition - windowStart - HISTORY_SIZE;
+        if (discard > 0) {
+            memmove(window.data(), window.data() + discard, windowFill - (size_t)discard);
+            windowStart += discard;
+            windowFill -= (size_t)discard;
+        }
+    }
+}
+
+// ファイルの offset から読む
+size_t MusicStream::ReadFile(Sint64 offset, Uint8* destination, size_t bytes) {
+    if (filePosition != offset) {
+        fseek(file, (long)offset, SEEK_SET);
+        filePosition = offset;
+    }
+    size_t count = fread(destination, 1, bytes, file);
+    filePosition += (Sint64)count;
+    return count;
+}
+
+// デコーダからの読み込み（窓に無ければその場でファイルから補充する）
+size_t MusicStream::Read(void* destination, size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Uint8* output = (Uint8*)destination;
+    size_t copied = 0;
+    while (copied < bytes && readPosition < fileSize) {
+        Sint64 offset = readPosition - windowStart;
+        if (offset >= 0 && offset < (Sint64)windowFill) {
+            size_t count = std::min(bytes - copied, windowFill - (size_t)offset);
+            memcpy(output + copied, window.data() + offset, count);
+            copied += count;
+            readPosition += (Sint64)count;
+            continue;
+        }
+        // 先読みが間に合わなかった（シーク直後など）
+        underruns++;
+        size_t before = windowFill;
+        Sint64 beforeStart = windowStart;
+        FillLocked();
+        if (windowFill == before && windowStart == beforeStart) break;  // これ以上読めない
+    }
+    return copied;
+}
+
+// デコーダからのシーク（位置だけ動かし、窓の作り直しは次の読み込み・先読みで行う）
+Sint64 MusicStream::Seek(Sint64 offset, int whence) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Sint64 base = whence == RW_SEEK_SET ? 0 : (whence == RW_SEEK_CUR ? readPosition : fileSize);
+    Sint64 target = base + offset;
+    if (target < 0) return -1;
+    readPosition = std::min(target, fileSize);
+    return readPosition;
+}
+
+// === SDL_RWops のコールバック ===
+
+Sint64 MusicStream::SizeCallback(SDL_RWops* context) {
+    return ((MusicStream*)context->hidden.unknown.data1)->fileSize;
+}
+
+Sint64 MusicStream::SeekCallback(SDL_RWops* context, Sint64 offset, int whence) {
+    return ((MusicStream*)context->hidden.unknown.data1)->Seek(offset, whence);
+}
+
+size_t MusicStream::ReadCallback(SDL_RWops* context, void* pointer, size_t size, size_t count) {
+    if (size == 0) return 0;
+    MusicStream* stream = (MusicStream*)context->hidden.unknown.data1;
+    return stream->Read(pointer, size * count) / size;
+}
+
+size_t MusicStream::WriteCallback(SDL_RWops*, const void*, size_t, size_t) {
+    return 0;  // 読み込み専用
+}
+
+int MusicStream::CloseCallback(SDL_RWops*) {
+    return 0;  // SDL_RWops はストリームのデストラクタで解放する
+}
+
+#endif  // SOUND_ENABLED
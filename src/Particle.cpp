@@ -1,4 +1,5 @@
 #include "Particle.h"
+#include "RenderProfiler.h"
 #include <cstdlib>
 
 // パーティクルのコンストラクタ
@@ -75,22 +76,26 @@ void Particle::Update() {
 }
 
 // パーティクルの描画
-void Particle::Render(SDL_Renderer* renderer) {
+void Particle::Render(SDL_Renderer* renderer, int cameraX, int cameraY) {
     if (!active) return;
     
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    // カメラオフセットを適用したスクリーン座標
+    int screenX = (int)x - cameraX;
+    int screenY = (int)y - cameraY;
+    
+    RenderProfiler::SetDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    RenderProfiler::SetDrawColor(renderer, color.r, color.g, color.b, color.a);
     
     // パーティクルタイプに応じて描画方法を変更
     if (type == PARTICLE_DASH_TRAIL) {
         // ダッシュ軌跡は少し大きめの矩形
-        SDL_Rect rect = {(int)(x - size/2), (int)(y - size/2), (int)size, (int)size};
-        SDL_RenderFillRect(renderer, &rect);
+        SDL_Rect rect = {screenX - (int)(size/2), screenY - (int)(size/2), (int)size, (int)size};
+        RenderProfiler::FillRect(renderer, &rect);
     } else {
         // その他は小さな矩形or点
         for (int i = 0; i < (int)size; i++) {
             for (int j = 0; j < (int)size; j++) {
-                SDL_RenderDrawPoint(renderer, (int)x + i - (int)size/2, (int)y + j - (int)size/2);
+                RenderProfiler::DrawPoint(renderer, screenX + i - (int)size/2, screenY + j - (int)size/2);
             }
         }
     }
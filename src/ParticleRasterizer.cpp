@@ -0,0 +1,280 @@
+#include "ParticleRasterizer.h"
+#include "RenderProfiler.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+// SSE2が使える環境ではSIMD版のブレンドを使用（x86-64では常に利用可能）
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLE_RASTERIZER_SSE2 1
+#endif
+
+namespace {
+
+// ワーカースレッド数の上限（呼び出し元スレッドを含む）
+const int MAX_RASTER_THREADS = 8;
+
+// 乗算済みアルファの「over」合成を1ピクセル分行う: dst = src + dst * (255 - alpha) / 255
+inline Uint32 BlendPixel(Uint32 dst, Uint32 src, Uint32 invAlpha) {
+    Uint32 result = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        Uint32 d = ((dst >> shift) & 0xFF) * invAlpha + 128;
+        d = (d + (d >> 8)) >> 8;  // 255での除算の近似（SIMD版と同じ式）
+        Uint32 s = (src >> shift) & 0xFF;
+        Uint32 c = d + s;
+        if (c > 255) c = 255;
+        result |= c << shift;
+    }
+    return result;
+}
+
+// 同じ色で横一列（count ピクセル）をブレンドする
+void BlendSpan(Uint32* dst, int count, Uint32 color, Uint32 alpha) {
+    Uint32 invAlpha = 255 - alpha;
+    int i = 0;
+#ifdef PARTICLE_RASTERIZER_SSE2
+    // 4ピクセルずつ16bitに展開して乗算し、飽和加算で元の色を足す
+    __m128i src = _mm_set1_epi32((int)color);
+    __m128i inv = _mm_set1_epi16((short)invAlpha);
+    __m128i round = _mm_set1_epi16(128);
+    __m128i zero = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4) {
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inv);
+        __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inv);
+        lo = _mm_add_epi16(lo, round);
+        hi = _mm_add_epi16(hi, round);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        d = _mm_adds_epu8(_mm_packus_epi16(lo, hi), src);
+        _mm_storeu_si128((__m128i*)(dst + i), d);
+    }
+#endif
+    // 残りのピクセル（またはSIMDが使えない環境）はスカラー版で処理
+    for (; i < count; i++) {
+        dst[i] = BlendPixel(dst[i], color, invAlpha);
+    }
+}
+
+// 乗算済みアルファを通常のアルファに戻す（乗算済みブレンドモードが使えない場合の転送用）
+inline Uint32 UnpremultiplyPixel(Uint32 pixel) {
+    Uint32 a = pixel >> 24;
+    if (a == 0) return 0;
+    if (a == 255) return pixel;
+    Uint32 r = std::min<Uint32>(255, ((pixel >> 16) & 0xFF) * 255 / a);
+    Uint32 g = std::min<Uint32>(255, ((pixel >> 8) & 0xFF) * 255 / a);
+    Uint32 b = std::min<Uint32>(255, (pixel & 0xFF) * 255 / a);
+    return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+} // namespace
+
+// コンストラクタ: バッファを確保し、ワーカースレッドを起動
+ParticleRasterizer::ParticleRasterizer(int width, int height)
+    : width(width), height(height), buffer(width * height, 0),
+      texture(nullptr), textureRenderer(nullptr), premultipliedBlend(false),
+      lockedPixels(nullptr), lockedPitch(0),
+      generation(0), stopping(false), nextBand(0), remainingBands(0) {
+
+    // スレッド数はCPUコア数に合わせる（呼び出し元スレッドも1つとして数える）
+    int threadCount = (int)std::thread::hardware_concurrency();
+    if (threadCount < 1) threadCount = 1;
+    if (threadCount > MAX_RASTER_THREADS) threadCount = MAX_RASTER_THREADS;
+
+    // 帯はスレッド数の2倍に分けて負荷の偏りを吸収する
+    bandCount = threadCount * 2;
+    bandHeight = (height + bandCount - 1) / bandCount;
+    bandSplats.resize(bandCount);
+
+    for (int i = 0; i < threadCount - 1; i++) {
+        workers.emplace_back(&ParticleRasterizer::WorkerLoop, this);
+    }
+
+    std::cout << "✨ CPUパーティクルラスタライザ初期化 (" << threadCount << " スレッド, "
+              << bandCount << " 帯)" << std::endl;
+}
+
+// デストラクタ: ワーカースレッドを停止してテクスチャを解放
+ParticleRasterizer::~ParticleRasterizer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    startCondition.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+}
+
+// ストリーミングテクスチャの作成
+bool ParticleRasterizer::EnsureTexture(SDL_Renderer* renderer) {
+    if (texture && textureRenderer == renderer) return true;
+
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+
+    texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, width, height);
+    if (!texture) {
+        std::cout << "⚠️ パーティクル用テクスチャ作成エラー: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    textureRenderer = renderer;
+
+    // 乗算済みアルファ用の合成（dst = src + dst * (1 - srcAlpha)）を設定
+    // 対応していないレンダラーでは通常のアルファブレンドにし、転送時にアルファを戻す
+    SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+    premultipliedBlend = (SDL_SetTextureBlendMode(texture, premultiplied) == 0);
+    if (!premultipliedBlend) {
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    }
+    return true;
+}
+
+// 可視パーティクルをラスタライズして画面に合成
+bool ParticleRasterizer::Render(SDL_Renderer* renderer, const std::vector<Particle>& particles,
+                                const std::vector<int>& visible, int cameraX, int cameraY) {
+    if (!EnsureTexture(renderer)) return false;
+
+    // === 描画情報の作成と帯への振り分け（Particle::Renderと同じ正方形） ===
+    splats.clear();
+    for (auto& band : bandSplats) {
+        band.clear();
+    }
+    for (int index : visible) {
+        const Particle& particle = particles[index];
+        if (!particle.active || particle.color.a == 0) continue;
+
+        int size = (int)particle.size;
+        if (size < 1) continue;
+        Splat splat;
+        splat.x0 = (int)particle.x - cameraX - size / 2;
+        splat.y0 = (int)particle.y - cameraY - size / 2;
+        splat.x1 = std::min(splat.x0 + size, width);
+        splat.y1 = std::min(splat.y0 + size, height);
+        splat.x0 = std::max(splat.x0, 0);
+        splat.y0 = std::max(splat.y0, 0);
+        if (splat.x0 >= splat.x1 || splat.y0 >= splat.y1) continue;
+
+        // 色をアルファで乗算しておく（ブレンド時の乗算を1回減らす）
+        Uint32 a = particle.color.a;
+        Uint32 r = (particle.color.r * a + 127) / 255;
+        Uint32 g = (particle.color.g * a + 127) / 255;
+        Uint32 b = (particle.color.b * a + 127) / 255;
+        splat.color = (a << 24) | (r << 16) | (g << 8) | b;
+        splat.alpha = a;
+
+        int splatIndex = (int)splats.size();
+        splats.push_back(splat);
+        int firstBand = splat.y0 / bandHeight;
+        int lastBand = (splat.y1 - 1) / bandHeight;
+        for (int band = firstBand; band <= lastBand; band++) {
+            bandSplats[band].push_back(splatIndex);
+        }
+    }
+
+    // === テクスチャをロックし、全帯を並列にラスタライズして書き込む ===
+    void* pixels = nullptr;
+    if (SDL_LockTexture(texture, nullptr, &pixels, &lockedPitch) != 0) {
+        std::cout << "⚠️ パーティクル用テクスチャのロックに失敗: " << SDL_GetError() << std::endl;
+        return false;
+    }
+    lockedPixels = (Uint8*)pixels;
+    RunBands();
+    SDL_UnlockTexture(texture);
+    lockedPixels = nullptr;
+
+    // === 1回の描画で画面に合成 ===
+    SDL_Rect destRect = {0, 0, width, height};
+    RenderProfiler::Copy(renderer, texture, nullptr, &destRect);
+    return true;
+}
+
+// 全帯をワーカーと分担して処理
+void ParticleRasterizer::RunBands() {
+    // 未完了数を先に設定してから帯の取り出しを再開する
+    remainingBands = bandCount;
+    nextBand = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        generation++;
+    }
+    startCondition.notify_all();
+
+    // 呼び出し元スレッドも帯を処理する
+    ProcessBands();
+
+    // 全帯の完了を待つ
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this] { return remainingBands.load() == 0; });
+}
+
+// 処理待ちの帯を取り出して処理
+void ParticleRasterizer::ProcessBands() {
+    int band;
+    while ((band = nextBand.fetch_add(1)) < bandCount) {
+        RasterizeBand(band);
+        if (remainingBands.fetch_sub(1) == 1) {
+            // 最後の帯を終えたスレッドが完了を通知
+            std::lock_guard<std::mutex> lock(mutex);
+            doneCondition.notify_all();
+        }
+    }
+}
+
+// 1つの帯をクリア・ブレンドし、テクスチャへ書き出す
+void ParticleRasterizer::RasterizeBand(int band) {
+    int rowStart = band * bandHeight;
+    int rowEnd = std::min(rowStart + bandHeight, height);
+    if (rowStart >= rowEnd) return;
+
+    // 帯をクリア（透明）
+    std::fill(buffer.begin() + rowStart * width, buffer.begin() + rowEnd * width, 0u);
+
+    // 登録順にブレンド（通常描画と同じ重なり順）
+    for (int splatIndex : bandSplats[band]) {
+        const Splat& splat = splats[splatIndex];
+        int y0 = std::max(splat.y0, rowStart);
+        int y1 = std::min(splat.y1, rowEnd);
+        int count = splat.x1 - splat.x0;
+        for (int y = y0; y < y1; y++) {
+            BlendSpan(&buffer[y * width + splat.x0], count, splat.color, splat.alpha);
+        }
+    }
+
+    // ロック中のテクスチャへ転送
+    for (int y = rowStart; y < rowEnd; y++) {
+        const Uint32* src = &buffer[y * width];
+        Uint32* dst = (Uint32*)(lockedPixels + y * lockedPitch);
+        if (premultipliedBlend) {
+            memcpy(dst, src, width * sizeof(Uint32));
+        } else {
+            for (int x = 0; x < width; x++) {
+                dst[x] = UnpremultiplyPixel(src[x]);
+            }
+        }
+    }
+}
+
+// ワーカースレッドのメインループ
+void ParticleRasterizer::WorkerLoop() {
+    int seenGeneration = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            startCondition.wait(lock, [this, seenGeneration] { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+        }
+        ProcessBands();
+    }
+}
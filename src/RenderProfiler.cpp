@@ -0,0 +1,192 @@
+#include "RenderProfiler.h"
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+
+// 静的メンバ変数の初期化
+bool RenderProfiler::enabled = false;
+int RenderProfiler::frames = 0;
+int RenderProfiler::drawCalls = 0;
+int RenderProfiler::stateChanges = 0;
+int RenderProfiler::redundantStateChanges = 0;
+int RenderProfiler::textureUploads = 0;
+std::vector<RenderProfiler::ZoneStats> RenderProfiler::zones;
+std::vector<int> RenderProfiler::zoneStack;
+std::vector<Uint64> RenderProfiler::zoneStarts;
+bool RenderProfiler::hasLastColor = false;
+SDL_Color RenderProfiler::lastColor = {0, 0, 0, 0};
+bool RenderProfiler::hasLastBlendMode = false;
+SDL_BlendMode RenderProfiler::lastBlendMode = SDL_BLENDMODE_NONE;
+
+// 集計の有効化・無効化
+void RenderProfiler::SetEnabled(bool enable) {
+    enabled = enable;
+    zoneStack.clear();
+    zoneStarts.clear();
+}
+
+// 集計結果をすべてクリア
+void RenderProfiler::Reset() {
+    frames = 0;
+    drawCalls = 0;
+    stateChanges = 0;
+    redundantStateChanges = 0;
+    textureUploads = 0;
+    zones.clear();
+    zoneStack.clear();
+    zoneStarts.clear();
+    hasLastColor = false;
+    hasLastBlendMode = false;
+}
+
+// 1フレーム分の描画終了
+void RenderProfiler::EndFrame() {
+    if (!enabled) return;
+    frames++;
+}
+
+// 計測ゾーンの開始
+void RenderProfiler::BeginZone(const char* name) {
+    if (!enabled) return;
+
+    // 同名のゾーンを探す（ゾーン数は少ないので線形探索）
+    int index = -1;
+    for (size_t i = 0; i < zones.size(); i++) {
+        if (zones[i].name == name || strcmp(zones[i].name, name) == 0) {
+            index = (int)i;
+            break;
+        }
+    }
+    if (index < 0) {
+        zones.push_back({name, 0, 0, 0, 0});
+        index = (int)zones.size() - 1;
+    }
+
+    zones[index].entries++;
+    zoneStack.push_back(index);
+    zoneStarts.push_back(SDL_GetPerformanceCounter());
+}
+
+// 計測ゾーンの終了
+void RenderProfiler::EndZone() {
+    if (!enabled || zoneStack.empty()) return;
+
+    Uint64 elapsed = SDL_GetPerformanceCounter() - zoneStarts.back();
+    zones[zoneStack.back()].ticks += elapsed;
+    zoneStack.pop_back();
+    zoneStarts.pop_back();
+}
+
+// 描画呼び出しを記録
+void RenderProfiler::CountDrawCall() {
+    drawCalls++;
+    if (!zoneStack.empty()) {
+        zones[zoneStack.back()].drawCalls++;
+    }
+}
+
+// ステート変更を記録
+void RenderProfiler::CountStateChange(bool redundant) {
+    stateChanges++;
+    if (redundant) {
+        redundantStateChanges++;
+    }
+    if (!zoneStack.empty()) {
+        zones[zoneStack.back()].stateChanges++;
+    }
+}
+
+// 描画色の設定
+int RenderProfiler::SetDrawColor(SDL_Renderer* renderer, Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+    if (enabled) {
+        bool redundant = hasLastColor && lastColor.r == r && lastColor.g == g &&
+                         lastColor.b == b && lastColor.a == a;
+        CountStateChange(redundant);
+        lastColor = {r, g, b, a};
+        hasLastColor = true;
+    }
+    return SDL_SetRenderDrawColor(renderer, r, g, b, a);
+}
+
+// ブレンドモードの設定
+int RenderProfiler::SetDrawBlendMode(SDL_Renderer* renderer, SDL_BlendMode blendMode) {
+    if (enabled) {
+        CountStateChange(hasLastBlendMode && lastBlendMode == blendMode);
+        lastBlendMode = blendMode;
+        hasLastBlendMode = true;
+    }
+    return SDL_SetRenderDrawBlendMode(renderer, blendMode);
+}
+
+// 画面クリア
+int RenderProfiler::Clear(SDL_Renderer* renderer) {
+    if (enabled) CountDrawCall();
+    return SDL_RenderClear(renderer);
+}
+
+// 矩形塗りつぶし
+int RenderProfiler::FillRect(SDL_Renderer* renderer, const SDL_Rect* rect) {
+    if (enabled) CountDrawCall();
+    return SDL_RenderFillRect(renderer, rect);
+}
+
+// 矩形の枠線
+int RenderProfiler::DrawRect(SDL_Renderer* renderer, const SDL_Rect* rect) {
+    if (enabled) CountDrawCall();
+    return SDL_RenderDrawRect(renderer, rect);
+}
+
+// 直線
+int RenderProfiler::DrawLine(SDL_Renderer* renderer, int x1, int y1, int x2, int y2) {
+    if (enabled) CountDrawCall();
+    return SDL_RenderDrawLine(renderer, x1, y1, x2, y2);
+}
+
+// 点
+int RenderProfiler::DrawPoint(SDL_Renderer* renderer, int x, int y) {
+    if (enabled) CountDrawCall();
+    return SDL_RenderDrawPoint(renderer, x, y);
+}
+
+// テクスチャのコピー
+int RenderProfiler::Copy(SDL_Renderer* renderer, SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect* dstRect) {
+    if (enabled) CountDrawCall();
+    return SDL_RenderCopy(renderer, texture, srcRect, dstRect);
+}
+
+// サーフェスからテクスチャを作成（アップロード回数を記録）
+SDL_Texture* RenderProfiler::CreateTextureFromSurface(SDL_Renderer* renderer, SDL_Surface* surface) {
+    if (enabled) textureUploads++;
+    return SDL_CreateTextureFromSurface(renderer, surface);
+}
+
+// 集計結果をコンソールに出力
+void RenderProfiler::PrintReport() {
+    double frequency = (double)SDL_GetPerformanceFrequency();
+    int frameCount = frames > 0 ? frames : 1;
+
+    std::cout << "📊 描画ベンチマーク結果 (" << frames << " フレーム)" << std::endl;
+    std::cout << "  描画呼び出し: " << drawCalls << " (" << (drawCalls / frameCount) << "/フレーム)" << std::endl;
+    std::cout << "  ステート変更: " << stateChanges << " (" << (stateChanges / frameCount) << "/フレーム, 冗長 "
+              << redundantStateChanges << ")" << std::endl;
+    std::cout << "  テクスチャ作成: " << textureUploads << " (" << (textureUploads / frameCount) << "/フレーム)" << std::endl;
+
+    std::cout << "  " << std::left << std::setw(14) << "zone"
+              << std::right << std::setw(10) << "total ms"
+              << std::setw(12) << "ms/entry"
+              << std::setw(10) << "entries"
+              << std::setw(10) << "draws"
+              << std::setw(10) << "states" << std::endl;
+    for (const ZoneStats& zone : zones) {
+        double totalMs = zone.ticks * 1000.0 / frequency;
+        double perEntryMs = zone.entries > 0 ? totalMs / zone.entries : 0.0;
+        std::cout << "  " << std::left << std::setw(14) << zone.name
+                  << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(10) << totalMs
+                  << std::setw(12) << perEntryMs
+                  << std::setw(10) << zone.entries
+                  << std::setw(10) << zone.drawCalls
+                  << std::setw(10) << zone.stateChanges << std::endl;
+    }
+    std::cout.unsetf(std::ios::fixed);
+}
@@ -0,0 +1,169 @@
+#ifdef SOUND_ENABLED
+
+#include "SoundMixer.h"
+#include <algorithm>
+#include <cmath>
+
+// 静的メンバの定義
+const int SoundMixer::MAX_VOICES;
+const int SoundMixer::MAX_VOICES_PER_SOUND;
+const Uint32 SoundMixer::COALESCE_WINDOW_MS;
+const int SoundMixer::FULL_VOLUME_DISTANCE;
+const int SoundMixer::MAX_AUDIBLE_DISTANCE;
+const int SoundMixer::PAN_DISTANCE;
+
+// コンストラクタ: チャンネルを確保
+SoundMixer::SoundMixer(AudioAssetManager* assets)
+    : assets(assets), baseVolume(MIX_MAX_VOLUME / 2), listenerX(0.0f), listenerY(0.0f) {
+    Mix_AllocateChannels(MAX_VOICES);
+    for (Voice& voice : voices) {
+        voice = {AudioAssetManager::INVALID_HANDLE, SOUND_PRIORITY_LOW, 0, 0, 0.0f};
+    }
+}
+
+// 再生を要求（位置なし: 常に最大音量・中央）
+void SoundMixer::Post(AudioAssetManager::Handle sound, int priority) {
+    if (sound == AudioAssetManager::INVALID_HANDLE) return;
+    requests.push_back({sound, priority, 1, false, 0.0f, 0.0f, 1.0f, 0.0f});
+}
+
+// 位置つきの再生を要求（音量と定位は Flush 時にまとめて計算する）
+void SoundMixer::PostAt(AudioAssetManager::Handle sound, int priority, float x, float y) {
+    if (sound == AudioAssetManager::INVALID_HANDLE) return;
+    requests.push_back({sound, priority, 1, true, x, y, 1.0f, 0.0f});
+}
+
+// リスナーの位置
+void SoundMixer::SetListener(float x, float y) {
+    listenerX = x;
+    listenerY = y;
+}
+
+// 集めた要求をまとめて鳴らす
+void SoundMixer::Flush(Uint32 now) {
+    if (requests.empty()) return;
+
+    // 距離で減衰させ、聞こえない要求をミキサーに渡す前に捨てる
+    Spatialize();
+    requests.clear();
+
+    // 優先度の高い要求からボイスを割り当てる
+    std::stable_sort(merged.begin(), merged.end(),
+                     [](const Request& a, const Request& b) { return a.priority > b.priority; });
+    for (const Request& request : merged) {
+        Play(request, now);
+    }
+    merged.clear();
+}
+
+// 位置つきの要求の音量と定位をまとめて計算し、聞こえない要求を捨てて音ごとにまとめる
+void SoundMixer::Spatialize() {
+    const float fadeRange = (float)(MAX_AUDIBLE_DISTANCE - FULL_VOLUME_DISTANCE);
+    for (Request& request : requests) {
+        if (!request.positional) continue;
+        float dx = request.x - listenerX;
+        float dy = request.y - listenerY;
+        float distance = std::sqrt(dx * dx + dy * dy);
+        request.gain = std::max(0.0f, std::min(1.0f, 1.0f - (distance - FULL_VOLUME_DISTANCE) / fadeRange));
+        request.pan = std::max(-1.0f, std::min(1.0f, dx / PAN_DISTANCE));
+    }
+
+    // 同じ音は1つにまとめる（一番大きく聞こえる要求の定位を使う）
+    for (const Request& request : requests) {
+        if (request.gain < MIN_AUDIBLE_GAIN) continue;
+        bool found = false;
+        for (Request& target : merged) {
+            if (target.sound != request.sound) continue;
+            target.count++;
+            target.priority = std::max(target.priority, request.priority);
+            if (request.gain > target.gain) {
+                target.gain = request.gain;
+                target.pan = request.pan;
+            }
+            found = true;
+            break;
+        }
+        if (!found) merged.push_back(request);
+    }
+}
+
+// 基本の音量
+void SoundMixer::SetVolume(int volume) {
+    baseVolume = std::max(0, std::min(MIX_MAX_VOLUME, volume));
+    Mix_Volume(-1, baseVolume);
+}
+
+// すべてのボイスを止める
+void SoundMixer::StopAll() {
+    Mix_HaltChannel(-1);
+    requests.clear();
+}
+
+// まとめた数と距離に応じた音量（要求が1つ増えるごとに+25%、上限は基本音量の2倍）
+int SoundMixer::CoalescedVolume(int count, float gain) const {
+    float boost = std::min(2.0f, 1.0f + 0.25f * (count - 1));
+    return std::min(MIX_MAX_VOLUME, (int)(baseVolume * boost * gain));
+}
+
+// 要求を1つ鳴らす
+void SoundMixer::Play(const Request& request, Uint32 now) {
+    // 読み込みが終わっていない音は鳴らさない
+    Mix_Chunk* chunk = assets->GetSound(request.sound);
+    if (!chunk) return;
+
+    // 同じ音のボイスを調べる（直前に鳴らしたボイスがあればそれを大きくするだけ）
+    int sameSoundVoices = 0;
+    int newest = -1;
+    int freeChannel = -1;
+    int victim = -1;
+    for (int channel = 0; channel < MAX_VOICES; channel++) {
+        Voice& voice = voices[channel];
+        if (!Mix_Playing(channel)) {
+            if (freeChannel < 0) freeChannel = channel;
+            continue;
+        }
+        if (voice.sound == request.sound) {
+            sameSoundVoices++;
+            if (newest < 0 || voice.startTime > voices[newest].startTime) newest = channel;
+        }
+        // 横取りの候補: 優先度が低く、古いボイス
+        if (victim < 0 || voice.priority < voices[victim].priority ||
+            (voice.priority == voices[victim].priority && voice.startTime < voices[victim].startTime)) {
+            victim = channel;
+        }
+    }
+
+    if (newest >= 0 && (now - voices[newest].startTime < COALESCE_WINDOW_MS ||
+                        sameSoundVoices >= MAX_VOICES_PER_SOUND)) {
+        // 重なりとして前のボイスを大きくする（新しいボイスは作らない）
+        Voice& voice = voices[newest];
+        voice.count += request.count;
+        voice.priority = std::max(voice.priority, request.priority);
+        voice.gain = std::max(voice.gain, request.gain);
+        Mix_Volume(newest, CoalescedVolume(voice.count, voice.gain));
+        return;
+    }
+
+    int channel = freeChannel;
+    if (channel < 0) {
+        // 空きがなければ、自分より優先度の低いボイスだけを横取りする
+        if (victim < 0 || voices[victim].priority >= request.priority) return;
+        channel = victim;
+        Mix_HaltChannel(channel);
+    }
+
+    Voice& voice = voices[channel];
+    voice.sound = request.sound;
+    voice.priority = request.priority;
+    voice.startTime = now;
+    voice.count = request.count;
+    voice.gain = request.gain;
+    Mix_Volume(channel, CoalescedVolume(voice.count, voice.gain));
+    // 定位（中央なら 255, 255 でパンニングのエフェクトが外れる）
+    Uint8 left = (Uint8)(255 * std::min(1.0f, 1.0f - request.pan));
+    Uint8 right = (Uint8)(255 * std::min(1.0f, 1.0f + request.pan));
+    Mix_SetPanning(channel, left, right);
+    Mix_PlayChannel(channel, chunk, 0);
+}
+
+#endif  // SOUND_ENABLED
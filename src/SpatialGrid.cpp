@@ -0,0 +1,98 @@
+#include "SpatialGrid.h"
+
+// 可視リストを空にする
+void VisibleLists::Clear() {
+    for (int i = 0; i < LAYER_COUNT; i++) {
+        indices[i].clear();
+    }
+}
+
+// 空間インデックスのコンストラクタ
+SpatialGrid::SpatialGrid(int cellSize)
+    : cellSize(cellSize), region({0, 0, 0, 0}), columns(0), rows(0),
+      maxEntryWidth(0), maxEntryHeight(0) {
+}
+
+// 領域に合わせてセルを確保し直す
+void SpatialGrid::Reset(const SDL_Rect& newRegion) {
+    region = newRegion;
+    columns = (region.w + cellSize - 1) / cellSize;
+    rows = (region.h + cellSize - 1) / cellSize;
+    if (columns < 1) columns = 1;
+    if (rows < 1) rows = 1;
+
+    // セル数が変わる場合のみ配列を作り直す（同じサイズなら容量を再利用）
+    if ((int)cells.size() != columns * rows) {
+        cells.resize(columns * rows);
+    }
+    Clear();
+}
+
+// 登録済みエントリをすべて削除
+void SpatialGrid::Clear() {
+    for (Cell& cell : cells) {
+        cell.first = -1;
+        cell.last = -1;
+    }
+    entries.clear();
+    maxEntryWidth = 0;
+    maxEntryHeight = 0;
+}
+
+// エントリを登録（左上のセルにのみ格納）
+void SpatialGrid::Insert(RenderLayer layer, int index, const SDL_Rect& bounds) {
+    if (cells.empty()) return;
+
+    // セルの末尾につなぐ（問い合わせの結果を登録順に保つ）
+    Cell& cell = cells[CellRow(bounds.y) * columns + CellColumn(bounds.x)];
+    int entryIndex = (int)entries.size();
+    entries.push_back({bounds, index, layer, -1});
+    if (cell.last >= 0) {
+        entries[cell.last].next = entryIndex;
+    } else {
+        cell.first = entryIndex;
+    }
+    cell.last = entryIndex;
+
+    if (bounds.w > maxEntryWidth) maxEntryWidth = bounds.w;
+    if (bounds.h > maxEntryHeight) maxEntryHeight = bounds.h;
+}
+
+// 矩形と重なるエントリをレイヤー別に追加
+void SpatialGrid::Query(const SDL_Rect& area, VisibleLists& out) const {
+    if (cells.empty()) return;
+
+    // 左上のセルにしか登録しないため、左・上方向は最大サイズ分だけ広げて探索する
+    int startColumn = CellColumn(area.x - maxEntryWidth);
+    int endColumn = CellColumn(area.x + area.w);
+    int startRow = CellRow(area.y - maxEntryHeight);
+    int endRow = CellRow(area.y + area.h);
+
+    for (int row = startRow; row <= endRow; row++) {
+        for (int column = startColumn; column <= endColumn; column++) {
+            for (int i = cells[row * columns + column].first; i >= 0; i = entries[i].next) {
+                // 候補の中から実際に重なるものだけを採用
+                const Entry& entry = entries[i];
+                if (SDL_HasIntersection(&entry.bounds, &area)) {
+                    out.indices[entry.layer].push_back(entry.index);
+                }
+            }
+        }
+    }
+}
+
+// ワールドX座標をセルの列に変換
+int SpatialGrid::CellColumn(int worldX) const {
+    int column = (worldX - region.x) / cellSize;
+    if (worldX < region.x) column = 0;
+    if (column >= columns) column = columns - 1;
+    return column;
+}
+
+// ワールドY座標をセルの行に変換
+int SpatialGrid::CellRow(int worldY) const {
+    int row = (worldY - region.y) / cellSize;
+    if (worldY < region.y) row = 0;
+    if (row >= rows) row = rows - 1;
+    return row;
+}
@@ -0,0 +1,335 @@
+#include "StageGenerator.h"
+#include "TileGrid.h"
+#include "Enemy.h"
+#include "Item.h"
+#include "Goal.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+const int W = StageGenerator::CHUNK_WIDTH;
+const int H = StageGenerator::STAGE_HEIGHT;
+const int TILE = TileGrid::TILE_SIZE;
+
+const int MIN_GROUND = 10;      // 地面の最も高い位置（行）
+const int MAX_GROUND = 17;      // 地面の最も低い位置（行、最下段の1つ上）
+const int MIN_PLATFORM = 4;     // 浮遊プラットフォームの最も高い位置（行、上に頭上の余裕を残す）
+const int EDGE_RUN = 4;         // チャンク両端の平地の幅（隣のチャンクと同じ高さでつなぐ）
+const int MAX_ATTEMPTS = 8;     // 到達できない地形を作り直す回数
+
+// 決定的な乱数（splitmix64）
+// 標準ライブラリの分布は実装ごとに結果が異なるため、同じシードで同じ地形になるよう自前で範囲を求める
+struct Random {
+    Uint64 state;
+
+    explicit Random(Uint64 seed) : state(seed) {}
+
+    Uint64 Next() {
+        Uint64 z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    // low 以上 high 以下の整数
+    int Range(int low, int high) {
+        if (high <= low) return low;
+        return low + (int)(Next() % (Uint64)(high - low + 1));
+    }
+    // percent% の確率で true
+    bool Chance(int percent) {
+        return Range(0, 99) < percent;
+    }
+};
+
+// シード値・チャンク番号・用途から乱数の初期値を作る
+Uint64 MixSeed(Uint32 seed, int index, int salt) {
+    return ((Uint64)seed << 32) ^ ((Uint64)(Uint32)index * 0x2545F4914F6CDD1Dull) ^ ((Uint64)salt << 56);
+}
+
+// 生成中のチャンク（地形を左から右へ1列ずつ置いていく）
+struct ChunkBuilder {
+    const PlayerReach& reach;
+    LevelChunk& chunk;
+    Random& rng;
+    int difficulty;             // 先に進むほど上がる（0-5）
+    int column;                 // 次に置く列
+    int ground;                 // 現在の地面の高さ（行）
+
+    ChunkBuilder(const PlayerReach& reach, LevelChunk& chunk, Random& rng, int entryGround)
+        : reach(reach), chunk(chunk), rng(rng),
+          difficulty(std::min(chunk.index / 8, 5)), column(0), ground(entryGround) {
+        chunk.tiles.assign(W * H, TILE_EMPTY);
+        chunk.enemies.clear();
+        chunk.items.clear();
+    }
+
+    int WorldX(int x) const { return (chunk.index * W + x) * TILE; }
+
+    void Block(int x, int y) {
+        chunk.tiles[y * W + x] = TILE_BLOCK;
+    }
+
+    // 現在の高さの地面を length 列置く
+    void Flat(int length) {
+        for (int i = 0; i < length && column < W; i++, column++) {
+            for (int y = ground; y < H; y++) {
+                Block(column, y);
+            }
+        }
+    }
+
+    // 穴（何も置かない列）を length 列空ける
+    void Pit(int length) {
+        column = std::min(W, column + length);
+    }
+
+    void AddEnemy(int x, int y, EnemyType type) {
+        chunk.enemies.push_back({WorldX(x), y, type});
+    }
+
+    void AddItem(int x, int row, ItemType type) {
+        // 組み込みステージと同じく、足場の1つ上の行から少し浮かせて置く
+        chunk.items.push_back({WorldX(x), (row - 1) * TILE - 25, type});
+    }
+
+    // 平地に敵・アイテムを置く（start から length 列、高さ ground）
+    void Populate(int start, int length) {
+        // 最初のチャンクの開始地点付近には置かない
+        if (chunk.index == 0 && start < 8) return;
+
+        if (length >= 4 && rng.Chance(std::min(25 + difficulty * 7, 60))) {
+            int x = start + length / 2;
+            int roll = rng.Range(0, 99);
+            if (roll < 35) {
+                AddEnemy(x, (ground - 1) * TILE, ENEMY_GOOMBA);
+            } else if (roll < 55) {
+                AddEnemy(x, (ground - 1) * TILE, ENEMY_CHASER);
+            } else if (roll < 70) {
+                AddEnemy(x, (ground - 1) * TILE, ENEMY_JUMPER);
+            } else if (roll < 85) {
+                AddEnemy(x, (ground - 1) * TILE, ENEMY_SHOOTER);
+            } else {
+                AddEnemy(x, std::max(1, ground - 5) * TILE, ENEMY_FLYING);  // 飛行敵は空中に
+            }
+        }
+
+        if (rng.Chance(30)) {
+            for (int x = start; x < start + std::min(length, 3); x++) {
+                AddItem(x, ground, COIN);
+            }
+        } else if (rng.Chance(5)) {
+            AddItem(start + length / 2, ground, POWER_MUSHROOM);
+        } else if (rng.Chance(1)) {
+            AddItem(start + length / 2, ground, LIFE_UP);
+        }
+    }
+
+    // 地面の高さを範囲内に収める
+    static int ClampGround(int value) {
+        return std::min(std::max(value, MIN_GROUND), MAX_GROUND);
+    }
+
+    // 現在の高さから target まで段差（ジャンプで登れる高さずつ）で近づくのに必要な列数
+    int ApproachWidth(int from, int target) const {
+        int steps = (std::abs(from - target) + reach.jumpHeight - 1) / reach.jumpHeight;
+        return steps * 2 + EDGE_RUN;
+    }
+
+    // 地形を1つ置く（置けなかった場合は false）
+    bool PlaceFeature(int exitGround) {
+        int feature = rng.Range(0, 4);
+        int gapMax = std::max(1, std::min(reach.gapWidth, 2 + difficulty));
+
+        if (feature == 1) {
+            // 段差: ジャンプで登れる高さまで上下する
+            int next = ClampGround(ground + rng.Range(-reach.jumpHeight, reach.jumpHeight));
+            int length = rng.Range(3, 5);
+            if (column + length + ApproachWidth(next, exitGround) > W) return false;
+            ground = next;
+            int start = column;
+            Flat(length);
+            Populate(start, length);
+        } else if (feature == 2) {
+            // 穴: 飛び越えられる幅だけ空け、着地点は同じか少し低い（1段までは高い）
+            int gap = rng.Range(std::min(2, gapMax), gapMax);
+            int next = ClampGround(ground + rng.Range(-std::min(1, reach.jumpHeight), 2));
+            int length = rng.Range(3, 4);
+            if (column + gap + length + ApproachWidth(next, exitGround) > W) return false;
+            // 穴の上に弧を描くコイン
+            int arcRow = std::max(MIN_PLATFORM, std::min(ground, next) - 2);
+            for (int x = column; x < column + gap; x++) {
+                AddItem(x, arcRow, COIN);
+            }
+            Pit(gap);
+            ground = next;
+            int start = column;
+            Flat(length);
+            Populate(start, length);
+        } else if (feature == 3) {
+            // 浮遊プラットフォーム: 穴の途中に足場を置き、2回のジャンプで渡る
+            int leftGap = rng.Range(1, gapMax);
+            int rightGap = rng.Range(1, gapMax);
+            int platformWidth = 3;
+            int platformRow = std::max(MIN_PLATFORM, ground - rng.Range(1, reach.jumpHeight));
+            int next = ClampGround(ground + rng.Range(-1, 1));
+            int length = rng.Range(3, 4);
+            int total = leftGap + platformWidth + rightGap + length;
+            if (column + total + ApproachWidth(next, exitGround) > W) return false;
+            Pit(leftGap);
+            for (int x = column; x < column + platformWidth; x++) {
+                Block(x, platformRow);
+                AddItem(x, platformRow, COIN);
+            }
+            Pit(platformWidth + rightGap);
+            ground = next;
+            int start = column;
+            Flat(length);
+            Populate(start, length);
+        } else if (feature == 4 && reach.climbHeight > reach.jumpHeight) {
+            // 高い壁: ジャンプでは届かず、壁登りで越える
+            int maxRise = std::min(reach.climbHeight, ground - MIN_GROUND);
+            if (maxRise <= reach.jumpHeight) return false;
+            int next = ground - rng.Range(reach.jumpHeight + 1, maxRise);
+            int length = rng.Range(3, 5);
+            if (column + length + ApproachWidth(next, exitGround) > W) return false;
+            ground = next;
+            int start = column;
+            Flat(length);
+            Populate(start, length);
+        } else {
+            // 平地
+            int length = rng.Range(3, 6);
+            if (column + length + ApproachWidth(ground, exitGround) > W) return false;
+            int start = column;
+            Flat(length);
+            Populate(start, length);
+        }
+        return true;
+    }
+
+    // 地形を置き、右端を exitGround の平地で終える（features=false なら段差だけでつなぐ）
+    void Build(int exitGround, bool features) {
+        Flat(EDGE_RUN);
+        if (features) {
+            // 置けない地形が続いたら出口へ向かう
+            int failures = 0;
+            while (failures < 3) {
+                if (PlaceFeature(exitGround)) {
+                    failures = 0;
+                } else {
+                    failures++;
+                }
+            }
+        }
+        // 出口の高さまで段差で近づく
+        while (ground != exitGround) {
+            int step = std::min(std::max(exitGround - ground, -reach.jumpHeight), reach.jumpHeight);
+            ground += step;
+            Flat(2);
+        }
+        Flat(W - column);
+    }
+};
+
+} // namespace
+
+// 静的メンバ定数の定義
+const int StageGenerator::CHUNK_WIDTH;
+const int StageGenerator::STAGE_HEIGHT;
+const int StageGenerator::CHUNK_COUNT;
+
+// コンストラクタ
+StageGenerator::StageGenerator(Uint32 seed, const PlayerReach& reach)
+    : seed(seed), reach(reach) {
+    // 段差と穴は最低1マスは越えられるものとして扱う
+    this->reach.jumpHeight = std::max(1, reach.jumpHeight);
+    this->reach.gapWidth = std::max(1, reach.gapWidth);
+}
+
+// チャンク境界の地面の高さ（最初の境界はプレイヤーの開始位置に合わせて一番低くする）
+int StageGenerator::BoundaryGround(int boundary) const {
+    if (boundary <= 0) return MAX_GROUND;
+    Random rng(MixSeed(seed, boundary, 0xFF));
+    return rng.Range(MIN_GROUND, MAX_GROUND);
+}
+
+// ステージ全体の情報
+bool StageGenerator::ReadInfo(LevelInfo& info) {
+    info.chunkWidth = CHUNK_WIDTH;
+    info.chunkCount = CHUNK_COUNT;
+    info.width = CHUNK_WIDTH * CHUNK_COUNT;
+    info.height = STAGE_HEIGHT;
+    info.playerStartX = 3 * TILE;
+    info.playerStartY = (MAX_GROUND - 2) * TILE;
+    // ゴールは最後のチャンクの右端（事実上到達しない）
+    info.goalType = GOAL_FLAG;
+    info.goalX = (info.width - 3) * TILE;
+    info.goalY = BoundaryGround(CHUNK_COUNT) * TILE - 64;
+    info.timeLimit = 0;
+    return true;
+}
+
+// チャンクを生成（到達できない地形は作り直し、それでも駄目なら段差だけでつなぐ）
+bool StageGenerator::LoadChunk(int index, LevelChunk& chunk) {
+    if (index < 0 || index >= CHUNK_COUNT) {
+        return false;
+    }
+    chunk.index = index;
+    int entryGround = BoundaryGround(index);
+    int exitGround = BoundaryGround(index + 1);
+
+    for (int attempt = 0; attempt <= MAX_ATTEMPTS; attempt++) {
+        Random rng(MixSeed(seed, index, attempt));
+        ChunkBuilder builder(reach, chunk, rng, entryGround);
+        builder.Build(exitGround, attempt < MAX_ATTEMPTS);
+        if (IsReachable(chunk.tiles, entryGround, exitGround)) {
+            return true;
+        }
+    }
+    return true;  // 段差だけの地形は常に到達できる
+}
+
+// チャンクの左端から右端まで到達できるか（立てる位置をジャンプ・壁登りでつないで幅優先探索）
+bool StageGenerator::IsReachable(const std::vector<Uint8>& tiles, int entryGround, int exitGround) const {
+    auto solid = [&tiles](int x, int y) {
+        return y >= 0 && y < H && TileHas(tiles[y * W + x], TILE_PROP_SOLID);
+    };
+
+    // 立てる位置（空いたマスの真下がブロック）を列挙
+    struct Spot { int x, y; };
+    std::vector<Spot> spots;
+    int start = -1, goal = -1;
+    for (int x = 0; x < W; x++) {
+        for (int y = 0; y < H - 1; y++) {
+            if (!solid(x, y) && solid(x, y + 1)) {
+                if (x == 0 && y == entryGround - 1) start = (int)spots.size();
+                if (x == W - 1 && y == exitGround - 1) goal = (int)spots.size();
+                spots.push_back({x, y});
+            }
+        }
+    }
+    if (start < 0 || goal < 0) return false;
+
+    std::vector<bool> visited(spots.size(), false);
+    std::vector<int> queue;
+    queue.push_back(start);
+    visited[start] = true;
+    for (size_t head = 0; head < queue.size(); head++) {
+        const Spot& from = spots[queue[head]];
+        if (queue[head] == goal) return true;
+        for (size_t i = 0; i < spots.size(); i++) {
+            if (visited[i]) continue;
+            const Spot& to = spots[i];
+            int dx = std::abs(to.x - from.x);
+            int rise = from.y - to.y;  // 正なら上へ
+            bool jump = rise <= reach.jumpHeight && dx <= reach.gapWidth + 1;
+            bool climb = rise <= reach.climbHeight && dx == 1;
+            if (jump || climb) {
+                visited[i] = true;
+                queue.push_back((int)i);
+            }
+        }
+    }
+    return false;
+}
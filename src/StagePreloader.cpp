@@ -0,0 +1,140 @@
+#include "StagePreloader.h"
+#include <iostream>
+
+// コンストラクタ: ワーカースレッドを起動
+StagePreloader::StagePreloader(Builder builder)
+    : builder(builder), stopping(false),
+      hasRequest(false), requestIndex(-1), buildingIndex(-1), buildingStale(false), ready(nullptr) {
+    worker = std::thread(&StagePreloader::WorkerLoop, this);
+}
+
+// デストラクタ: ワーカースレッドを停止し、未使用の状態を破棄
+StagePreloader::~StagePreloader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workCondition.notify_all();
+    worker.join();
+
+    delete ready;
+    for (PreparedStage* stage : garbage) {
+        delete stage;
+    }
+}
+
+// 先読みを要求
+void StagePreloader::Request(int stageIndex, const StageData& stage) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if ((ready && ready->stageIndex == stageIndex) || (buildingIndex == stageIndex && !buildingStale)) {
+            return;  // 作成済み・作成中
+        }
+        hasRequest = true;
+        requestIndex = stageIndex;
+        requestStage = stage;
+    }
+    workCondition.notify_one();
+}
+
+// 先読み済みの状態を取り出す
+PreparedStage* StagePreloader::Take(int stageIndex) {
+    std::unique_lock<std::mutex> lock(mutex);
+    // 要求済み・作成中なら完了を待つ（同じものをこのスレッドで作り直すより早い）
+    // 無効になった作成中の状態は使わないので待たない
+    doneCondition.wait(lock, [this, stageIndex] {
+        return !(hasRequest && requestIndex == stageIndex) && (buildingIndex != stageIndex || buildingStale);
+    });
+
+    if (ready && ready->stageIndex == stageIndex) {
+        PreparedStage* stage = ready;
+        ready = nullptr;
+        return stage;
+    }
+    return nullptr;
+}
+
+// 不要になった状態をワーカースレッドで破棄
+void StagePreloader::Recycle(PreparedStage* stage) {
+    if (!stage) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        garbage.push_back(stage);
+    }
+    workCondition.notify_one();
+}
+
+// ステージの先読みを無効にする
+void StagePreloader::Invalidate(int stageIndex) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (hasRequest && requestIndex == stageIndex) {
+            hasRequest = false;
+        }
+        if (buildingIndex == stageIndex) {
+            buildingStale = true;
+        }
+        if (ready && ready->stageIndex == stageIndex) {
+            garbage.push_back(ready);
+            ready = nullptr;
+        }
+    }
+    // 未着手の要求を取り消した場合に Take の待ちを終わらせる
+    doneCondition.notify_all();
+    workCondition.notify_one();
+}
+
+// ワーカースレッドのメインループ
+void StagePreloader::WorkerLoop() {
+    while (true) {
+        std::vector<PreparedStage*> trash;
+        StageData stage;
+        int index = -1;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            workCondition.wait(lock, [this] { return stopping || hasRequest || !garbage.empty(); });
+            if (stopping) return;
+
+            trash.swap(garbage);
+            if (hasRequest) {
+                index = requestIndex;
+                stage = std::move(requestStage);
+                hasRequest = false;
+                buildingIndex = index;
+                buildingStale = false;
+            }
+        }
+
+        // 前のステージの状態を破棄（メインスレッドの代わりに解放する）
+        for (PreparedStage* old : trash) {
+            delete old;
+        }
+        if (index < 0) continue;
+
+        // 次のステージの実行時状態を作る
+        PreparedStage* prepared = builder(stage);
+        prepared->stageIndex = index;
+
+        PreparedStage* replaced = nullptr;
+        bool stale;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stale = buildingStale;
+            if (stale) {
+                // 作成中に無効になった: 使わずに捨てる
+                replaced = prepared;
+            } else {
+                replaced = ready;
+                ready = prepared;
+            }
+            buildingIndex = -1;
+            buildingStale = false;
+        }
+        doneCondition.notify_all();
+        delete replaced;
+
+        if (!stale) {
+            std::cout << "⏩ " << stage.stageName << " を先読みしました" << std::endl;
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#include "StageWatcher.h"
+#include <iostream>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#endif
+
+// コンストラクタ: inotifyが使えればノンブロッキングで初期化
+StageWatcher::StageWatcher() : inotifyFd(-1), pollCountdown(POLL_INTERVAL_FRAMES) {
+#ifdef __linux__
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) {
+        std::cout << "⚠️ inotifyを使えないため更新時刻でステージファイルを監視します" << std::endl;
+    }
+#endif
+}
+
+// デストラクタ: 監視を終了
+StageWatcher::~StageWatcher() {
+#ifdef __linux__
+    if (inotifyFd >= 0) {
+        close(inotifyFd);
+    }
+#endif
+}
+
+// ファイルの最終更新時刻
+long long StageWatcher::ModifiedTime(const std::string& path) {
+    struct stat fileStat;
+    if (stat(path.c_str(), &fileStat) != 0) {
+        return -1;
+    }
+    return (long long)fileStat.st_mtime;
+}
+
+// ファイルを監視対象に追加
+bool StageWatcher::Watch(const std::string& path) {
+    files[path] = ModifiedTime(path);
+
+#ifdef __linux__
+    if (inotifyFd >= 0) {
+        // ファイルそのものではなくディレクトリを監視する
+        // （コンパイラは一時ファイルに書いてから置き換えるため、元のファイルの監視は外れてしまう）
+        // その場での書き込み（IN_CLOSE_WRITE）は、マップ中のファイルが変わってしまうので対象にしない
+        size_t slash = path.find_last_of('/');
+        std::string directory = slash == std::string::npos ? "." : path.substr(0, slash);
+        for (const auto& entry : watchedDirectories) {
+            if (entry.second == directory) return true;
+        }
+        int watch = inotify_add_watch(inotifyFd, directory.c_str(), IN_MOVED_TO);
+        if (watch < 0) {
+            std::cout << "⚠️ ディレクトリを監視できません: " << directory << std::endl;
+            return false;
+        }
+        watchedDirectories[watch] = directory;
+    }
+#endif
+    return true;
+}
+
+// 変更された監視対象を報告
+void StageWatcher::Poll(std::vector<std::string>& changed) {
+    std::set<std::string> found;
+    if (inotifyFd >= 0) {
+        ReadEvents(found);
+    } else if (--pollCountdown <= 0) {
+        pollCountdown = POLL_INTERVAL_FRAMES;
+        ScanModifiedTimes(found);
+    }
+    changed.insert(changed.end(), found.begin(), found.end());
+}
+
+// inotifyのイベントを読み出す（同じファイルの複数のイベントは1回にまとめる）
+void StageWatcher::ReadEvents(std::set<std::string>& changed) {
+#ifdef __linux__
+    alignas(struct inotify_event) char buffer[4096];
+    while (true) {
+        ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) break;  // EAGAIN: 未読のイベントなし
+
+        for (char* cursor = buffer; cursor < buffer + length; ) {
+            const struct inotify_event* event = (const struct inotify_event*)cursor;
+            cursor += sizeof(struct inotify_event) + event->len;
+            if (event->len == 0) continue;
+
+            auto directory = watchedDirectories.find(event->wd);
+            if (directory == watchedDirectories.end()) continue;
+            std::string path = directory->second + "/" + event->name;
+            auto file = files.find(path);
+            if (file != files.end()) {
+                file->second = ModifiedTime(path);
+                changed.insert(path);
+            }
+        }
+    }
+#else
+    (void)changed;
+#endif
+}
+
+// 更新時刻を比較して変更を検出する
+void StageWatcher::ScanModifiedTimes(std::set<std::string>& changed) {
+    for (auto& file : files) {
+        long long modified = ModifiedTime(file.first);
+        if (modified >= 0 && modified != file.second) {
+            file.second = modified;
+            changed.insert(file.first);
+        }
+    }
+}
@@ -0,0 +1,122 @@
+#include "StartupProfiler.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <string>
+
+// 静的メンバ変数の初期化
+std::mutex StartupProfiler::mutex;
+bool StartupProfiler::running = false;
+Uint64 StartupProfiler::startTime = 0;
+Uint64 StartupProfiler::firstFrameTime = 0;
+std::vector<StartupProfiler::Phase> StartupProfiler::phases;
+std::vector<std::thread::id> StartupProfiler::threads;
+
+namespace {
+
+// タイムラインのバーの幅（文字数）
+const int BAR_WIDTH = 40;
+
+} // namespace
+
+// 計測を開始
+void StartupProfiler::Start() {
+    std::lock_guard<std::mutex> lock(mutex);
+    running = true;
+    startTime = SDL_GetPerformanceCounter();
+    firstFrameTime = 0;
+    phases.clear();
+    threads.clear();
+    threads.push_back(std::this_thread::get_id());
+}
+
+// 計測を打ち切る
+void StartupProfiler::Stop() {
+    std::lock_guard<std::mutex> lock(mutex);
+    running = false;
+    phases.clear();
+    threads.clear();
+}
+
+bool StartupProfiler::IsRunning() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return running;
+}
+
+// 呼び出し元スレッドの番号（初めて記録したスレッドには新しい番号を振る）
+int StartupProfiler::ThreadNumber() {
+    std::thread::id id = std::this_thread::get_id();
+    for (size_t i = 0; i < threads.size(); i++) {
+        if (threads[i] == id) return (int)i;
+    }
+    threads.push_back(id);
+    return (int)threads.size() - 1;
+}
+
+// フェーズを記録
+void StartupProfiler::Record(const char* name, Uint64 start, Uint64 end) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!running) return;
+    phases.push_back({name, ThreadNumber(), start, end});
+}
+
+// 最初のフレームを表示した時刻を記録
+void StartupProfiler::MarkFirstFrame() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!running || firstFrameTime != 0) return;
+    firstFrameTime = SDL_GetPerformanceCounter();
+}
+
+// タイムラインをコンソールに出力
+// 例:   font            worker2         5.2      40.1  [     #######      |     ]  （| は最初のフレーム）
+void StartupProfiler::PrintReport() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!running) return;
+    running = false;
+
+    double frequency = (double)SDL_GetPerformanceFrequency();
+    Uint64 endTime = firstFrameTime;
+    for (const Phase& phase : phases) {
+        endTime = std::max(endTime, phase.end);
+    }
+    double totalMs = std::max(1e-3, (endTime - startTime) * 1000.0 / frequency);
+    auto toMs = [&](Uint64 time) { return (time - startTime) * 1000.0 / frequency; };
+
+    std::cout << "⏱️ 起動タイムライン";
+    if (firstFrameTime != 0) {
+        std::cout << std::fixed << std::setprecision(1)
+                  << " (最初のフレームまで " << toMs(firstFrameTime) << " ms)";
+    }
+    std::cout << std::endl;
+    std::cout << "  " << std::left << std::setw(16) << "phase"
+              << std::setw(10) << "thread"
+              << std::right << std::setw(10) << "start ms"
+              << std::setw(10) << "ms" << std::endl;
+
+    // 開始時刻順に並べる（ワーカースレッドのフェーズは終了時に記録されるため）
+    std::stable_sort(phases.begin(), phases.end(),
+                     [](const Phase& a, const Phase& b) { return a.start < b.start; });
+
+    int firstFrameColumn = firstFrameTime != 0 ? (int)(toMs(firstFrameTime) / totalMs * BAR_WIDTH) : -1;
+    for (const Phase& phase : phases) {
+        double startMs = toMs(phase.start);
+        double endMs = toMs(phase.end);
+        int from = std::min(BAR_WIDTH - 1, (int)(startMs / totalMs * BAR_WIDTH));
+        int to = std::max(from + 1, std::min(BAR_WIDTH, (int)(endMs / totalMs * BAR_WIDTH + 0.5)));
+        std::string bar(BAR_WIDTH, ' ');
+        if (firstFrameColumn >= 0 && firstFrameColumn < BAR_WIDTH) bar[firstFrameColumn] = '|';
+        std::fill(bar.begin() + from, bar.begin() + to, '#');
+
+        std::string thread = phase.thread == 0 ? "main" : "worker" + std::to_string(phase.thread);
+        std::cout << "  " << std::left << std::setw(16) << phase.name
+                  << std::setw(10) << thread
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << startMs
+                  << std::setw(10) << (endMs - startMs)
+                  << "  [" << bar << "]" << std::endl;
+    }
+    std::cout.unsetf(std::ios::fixed);
+
+    phases.clear();
+    threads.clear();
+}
@@ -0,0 +1,44 @@
+#include "TileGrid.h"
+#include <algorithm>
+#include <cstring>
+
+// コンストラクタ: 空のグリッド
+TileGrid::TileGrid() : width(0), height(0), originX(0), worldWidth(0) {
+}
+
+// コンストラクタ: 指定サイズの空グリッド
+TileGrid::TileGrid(int width, int height) : width(0), height(0), originX(0), worldWidth(0) {
+    Resize(width, height);
+}
+
+// サイズを変更し、全タイルを空にする
+void TileGrid::Resize(int newWidth, int newHeight) {
+    width = std::max(0, newWidth);
+    height = std::max(0, newHeight);
+    originX = 0;
+    worldWidth = width;
+    tiles.assign((size_t)width * height, TILE_EMPTY);
+}
+
+// 保持している列のステージ内位置を設定
+void TileGrid::SetWindow(int newOriginX, int newWorldWidth) {
+    originX = newOriginX;
+    worldWidth = newWorldWidth;
+}
+
+// 行優先のタイル列をまとめてコピー
+void TileGrid::Assign(const Uint8* data, int newWidth, int newHeight) {
+    width = std::max(0, newWidth);
+    height = std::max(0, newHeight);
+    originX = 0;
+    worldWidth = width;
+    tiles.resize((size_t)width * height);
+    if (!tiles.empty()) {
+        memcpy(tiles.data(), data, tiles.size());
+    }
+}
+
+// 全タイルを指定の値で埋める
+void TileGrid::Fill(Uint8 value) {
+    std::fill(tiles.begin(), tiles.end(), value);
+}
@@ -2,6 +2,9 @@
 #include "Game.h"
 // C++標準ライブラリ: コンソール出力（std::cout）用
 #include <iostream>
+// C++標準ライブラリ: 文字列比較・数値変換（コマンドライン引数の解析）用
+#include <cstring>
+#include <cstdlib>
 
 // 画面幅の定数定義（ピクセル単位）- マリオ風ゲームに合わせて調整
 const int SCREEN_WIDTH = 800;
@@ -23,6 +26,77 @@ int main(int argc, char* argv[]) {
     // Gameクラスのインスタンスを動的に作成（ヒープメモリに確保）
     Game* game = new Game();
     
+    // === 描画ベンチマークモード ===
+    // 使い方: --bench-render <フレーム数> [--checksum] [--cpu-particles]
+    // ウィンドウを作らずオフスクリーンで決定的なシーンを描画し、描画統計を出力して終了する
+    // === ストリーミングステージ ===
+    // 使い方: --export-stage <ステージ番号> <ディレクトリ>  組み込みステージをチャンクファイルに書き出して終了
+    //         --stream-stage <ディレクトリ>                 チャンクファイルのステージを最初のステージにする
+    //         --endless <シード値>                          手続き生成の果てしないステージを最初のステージにする
+    // === 入力 ===
+    // 使い方: --input-buffer <ミリ秒>    ジャンプ・ダッシュ・攻撃の押下を保持する時間（既定は100ms）
+    //         --record-input <ファイル>   ティックごとの操作をファイルに記録する
+    //         --replay-input <ファイル>   記録した操作を再生する（記録の終わりからは実際の入力で操作）
+    //         --latency                   押下から表示までの遅延を計測し、終了時に内訳の分布を出力する
+    // === ヒープ確保のチェック（TRACK_ALLOCATIONS ビルドのみ） ===
+    // 使い方: --alloc-check <ファイル> [--alloc-warmup <フレーム数>]
+    // 記録した操作をオフスクリーンで再生し、ウォームアップ（既定120フレーム）後に確保があれば終了コード1で終了する
+    int benchmarkFrames = 0;
+    bool benchmarkChecksum = false;
+    const char* allocationCheckReplay = nullptr;
+    int allocationCheckWarmup = 120;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--bench-render") == 0 && i + 1 < argc) {
+            benchmarkFrames = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--checksum") == 0) {
+            benchmarkChecksum = true;
+        } else if (strcmp(argv[i], "--cpu-particles") == 0) {
+            // CPUパーティクル描画を強制し、大量パーティクルで計測する
+            game->EnableCpuParticles(200000);
+        } else if (strcmp(argv[i], "--export-stage") == 0 && i + 2 < argc) {
+            bool exported = game->ExportStage(atoi(argv[i + 1]), argv[i + 2]);
+            delete game;
+            return exported ? 0 : 1;
+        } else if (strcmp(argv[i], "--stream-stage") == 0 && i + 1 < argc) {
+            if (!game->AddStreamedStage(argv[++i])) {
+                delete game;
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--endless") == 0 && i + 1 < argc) {
+            game->AddGeneratedStage((Uint32)strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--input-buffer") == 0 && i + 1 < argc) {
+            game->SetInputBufferWindow((Uint32)strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--record-input") == 0 && i + 1 < argc) {
+            game->StartInputRecording(argv[++i]);
+        } else if (strcmp(argv[i], "--replay-input") == 0 && i + 1 < argc) {
+            game->StartInputReplay(argv[++i]);
+        } else if (strcmp(argv[i], "--latency") == 0) {
+            LatencyTracker::SetEnabled(true);
+        } else if (strcmp(argv[i], "--alloc-check") == 0 && i + 1 < argc) {
+            allocationCheckReplay = argv[++i];
+        } else if (strcmp(argv[i], "--alloc-warmup") == 0 && i + 1 < argc) {
+            allocationCheckWarmup = atoi(argv[++i]);
+        }
+    }
+    if (benchmarkFrames > 0) {
+        int exitCode = 1;
+        if (game->InitializeHeadless(SCREEN_WIDTH, SCREEN_HEIGHT)) {
+            game->RunRenderBenchmark(benchmarkFrames, benchmarkChecksum);
+            exitCode = 0;
+        }
+        delete game;
+        return exitCode;
+    }
+    if (allocationCheckReplay) {
+        int exitCode = 1;
+        if (game->InitializeHeadless(SCREEN_WIDTH, SCREEN_HEIGHT) &&
+            game->RunAllocationCheck(allocationCheckReplay, allocationCheckWarmup)) {
+            exitCode = 0;
+        }
+        delete game;
+        return exitCode;
+    }
+    
     // ゲーム初期化を実行: ウィンドウ作成、SDL初期化など
     // タイトル="Mario-style 2D Game", 位置=画面中央, サイズ=800x608, フルスクリーン=false
     if (game->Initialize("Mario-style 2D Game", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 
@@ -50,9 +124,9 @@ int main(int argc, char* argv[]) {
             // フレーム処理開始時刻を記録（フレームレート制御用）
             frameStart = SDL_GetTicks();
             
-            // イベント処理: キーボード入力、マウス操作、ウィンドウ閉じるボタンなど
+            // イベント処理: ウィンドウ閉じるボタンなど、キーとボタンの入力はタイムスタンプ付きで記録
             game->HandleEvents();
-            // ゲーム状態更新: プレイヤー位置、物理計算、敵AI、衝突判定など
+            // ゲーム状態更新: 経過時間の分だけ固定ステップのティックを進める（入力処理、物理計算、敵AI、衝突判定など）
             game->Update();
             // 画面描画: 背景クリア、マップ描画、プレイヤー・敵描画、画面更新
             game->Render();
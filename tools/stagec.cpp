@@ -0,0 +1,240 @@
+// ステージコンパイラ: テキスト形式のステージ記述をバイナリのステージファイル（.stg）に変換する
+// 使い方: stagec <入力.stage> <出力.stg>
+//
+// 入力形式（1行1命令、# 以降はコメント）:
+//   name Stage 1 - Tutorial        ステージ名
+//   number 1                       ステージ番号
+//   size 100 19                    幅・高さ（タイル単位）
+//   player 100 300                 プレイヤー開始位置（ピクセル）
+//   goal flag 3050 448             ゴールの種類（flag / door / collect）と位置
+//   time 240                       制限時間（秒、0=無制限）
+//   bgm boss_battle.ogg            BGMファイル名
+//   tiles                          続く height 行がタイル（'.'=空, '#'=ブロック, '='=すり抜け床, '^'=トゲ, '~'=氷）
+//   enemy 400 512 shooter          敵（goomba / shooter / jumper / chaser / flying）
+//   item 266 487 coin              アイテム（coin / mushroom / lifeup）
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdio>
+
+#include "StageFormat.h"
+#include "TileProperties.h"
+#include "Enemy.h"
+#include "Item.h"
+#include "Goal.h"
+
+namespace {
+
+// 名前と値の対応表
+struct NamedValue {
+    const char* name;
+    int value;
+};
+
+const NamedValue GOAL_TYPES[] = {
+    {"flag", GOAL_FLAG}, {"door", GOAL_DOOR}, {"collect", GOAL_COLLECT_ALL}
+};
+const NamedValue ENEMY_TYPES[] = {
+    {"goomba", ENEMY_GOOMBA}, {"shooter", ENEMY_SHOOTER}, {"jumper", ENEMY_JUMPER},
+    {"chaser", ENEMY_CHASER}, {"flying", ENEMY_FLYING}
+};
+const NamedValue ITEM_TYPES[] = {
+    {"coin", COIN}, {"mushroom", POWER_MUSHROOM}, {"lifeup", LIFE_UP}
+};
+// タイル文字（文字の位置がタイルID）
+constexpr char TILE_CHARS[] = ".#=^~";
+static_assert(TILE_CHARS[TILE_BLOCK] == '#' && TILE_CHARS[TILE_ICE] == '~', "タイル文字とタイルIDの対応");
+
+template <size_t N>
+bool LookUp(const NamedValue (&table)[N], const std::string& name, int32_t& value) {
+    for (const NamedValue& entry : table) {
+        if (name == entry.name) {
+            value = entry.value;
+            return true;
+        }
+    }
+    return false;
+}
+
+// コンパイル中のステージ
+struct StageSource {
+    StageFileHeader header;
+    std::string name;
+    std::string bgm;
+    std::vector<uint8_t> tiles;
+    std::vector<StageFileSpawn> enemies;
+    std::vector<StageFileSpawn> items;
+};
+
+// エラー表示（ファイル名:行番号）
+bool Fail(const std::string& path, int line, const std::string& message) {
+    std::cerr << path << ":" << line << ": " << message << std::endl;
+    return false;
+}
+
+// 行の残りを文字列として取得（先頭の空白を除く）
+std::string Rest(std::istringstream& stream) {
+    std::string rest;
+    std::getline(stream, rest);
+    size_t start = rest.find_first_not_of(" \t");
+    return start == std::string::npos ? "" : rest.substr(start);
+}
+
+// テキスト形式のステージ記述を読み込む
+bool Parse(const std::string& path, StageSource& stage) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "入力ファイルを開けません: " << path << std::endl;
+        return false;
+    }
+
+    memset(&stage.header, 0, sizeof(stage.header));
+    stage.header.stageNumber = 1;
+    stage.header.playerStartX = 100;
+    stage.header.playerStartY = 300;
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        std::string text = line;
+        // タイル行以外はコメントを除去（タイル行は tiles 命令の中で直接読む）
+        if (comment != std::string::npos) text = line.substr(0, comment);
+        std::istringstream stream(text);
+        std::string command;
+        if (!(stream >> command)) continue;
+
+        StageFileHeader& header = stage.header;
+        if (command == "name") {
+            stage.name = Rest(stream);
+        } else if (command == "number") {
+            if (!(stream >> header.stageNumber)) return Fail(path, lineNumber, "number の値が不正です");
+        } else if (command == "size") {
+            if (!(stream >> header.width >> header.height) || header.width <= 0 || header.height <= 0) {
+                return Fail(path, lineNumber, "size の値が不正です");
+            }
+        } else if (command == "player") {
+            if (!(stream >> header.playerStartX >> header.playerStartY)) return Fail(path, lineNumber, "player の値が不正です");
+        } else if (command == "goal") {
+            std::string type;
+            if (!(stream >> type >> header.goalX >> header.goalY) || !LookUp(GOAL_TYPES, type, header.goalType)) {
+                return Fail(path, lineNumber, "goal の値が不正です");
+            }
+        } else if (command == "time") {
+            if (!(stream >> header.timeLimit)) return Fail(path, lineNumber, "time の値が不正です");
+        } else if (command == "bgm") {
+            stage.bgm = Rest(stream);
+        } else if (command == "tiles") {
+            if (header.width <= 0) return Fail(path, lineNumber, "tiles の前に size が必要です");
+            stage.tiles.assign((size_t)header.width * header.height, 0);
+            for (int y = 0; y < header.height; y++) {
+                if (!std::getline(file, line)) return Fail(path, lineNumber, "タイルの行が足りません");
+                lineNumber++;
+                if ((int)line.size() < header.width) return Fail(path, lineNumber, "タイルの行が短すぎます");
+                for (int x = 0; x < header.width; x++) {
+                    const char* kind = strchr(TILE_CHARS, line[x]);
+                    if (!kind || line[x] == '\0') return Fail(path, lineNumber, "不明なタイル文字です");
+                    stage.tiles[(size_t)y * header.width + x] = (Uint8)(kind - TILE_CHARS);
+                }
+            }
+        } else if (command == "enemy" || command == "item") {
+            StageFileSpawn spawn;
+            std::string type;
+            bool valid = (bool)(stream >> spawn.x >> spawn.y >> type);
+            if (command == "enemy") {
+                if (!valid || !LookUp(ENEMY_TYPES, type, spawn.type)) return Fail(path, lineNumber, "enemy の値が不正です");
+                stage.enemies.push_back(spawn);
+            } else {
+                if (!valid || !LookUp(ITEM_TYPES, type, spawn.type)) return Fail(path, lineNumber, "item の値が不正です");
+                stage.items.push_back(spawn);
+            }
+        } else {
+            return Fail(path, lineNumber, "不明な命令です: " + command);
+        }
+    }
+
+    if (stage.tiles.empty()) {
+        return Fail(path, lineNumber, "tiles がありません");
+    }
+    return true;
+}
+
+// バイナリのステージファイルを書き出す
+bool Write(const std::string& path, StageSource& stage) {
+    StageFileHeader& header = stage.header;
+    header.magic = STAGE_FILE_MAGIC;
+    header.version = STAGE_FILE_VERSION;
+
+    // 各セクションの配置を決める
+    uint32_t offset = sizeof(StageFileHeader);
+    header.tilesOffset = offset;
+    offset = AlignStageOffset(offset + (uint32_t)stage.tiles.size());
+    header.enemyCount = (uint32_t)stage.enemies.size();
+    header.enemiesOffset = offset;
+    offset += header.enemyCount * sizeof(StageFileSpawn);
+    header.itemCount = (uint32_t)stage.items.size();
+    header.itemsOffset = offset;
+    offset += header.itemCount * sizeof(StageFileSpawn);
+    header.nameOffset = offset;
+    header.nameLength = (uint32_t)stage.name.size();
+    offset += header.nameLength;
+    header.bgmOffset = offset;
+    header.bgmLength = (uint32_t)stage.bgm.size();
+    offset += header.bgmLength;
+    header.fileSize = offset;
+
+    std::vector<char> buffer(header.fileSize, 0);
+    memcpy(&buffer[0], &header, sizeof(header));
+    memcpy(&buffer[header.tilesOffset], stage.tiles.data(), stage.tiles.size());
+    if (header.enemyCount > 0) {
+        memcpy(&buffer[header.enemiesOffset], stage.enemies.data(), header.enemyCount * sizeof(StageFileSpawn));
+    }
+    if (header.itemCount > 0) {
+        memcpy(&buffer[header.itemsOffset], stage.items.data(), header.itemCount * sizeof(StageFileSpawn));
+    }
+    memcpy(&buffer[header.nameOffset], stage.name.data(), header.nameLength);
+    memcpy(&buffer[header.bgmOffset], stage.bgm.data(), header.bgmLength);
+
+    // 一時ファイルに書いてから置き換える
+    // （実行中のゲームがマップしている古いファイルの内容は置き換え後も有効なまま残る）
+    std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary);
+        if (!file || !file.write(buffer.data(), buffer.size())) {
+            std::cerr << "出力ファイルに書き込めません: " << temporaryPath << std::endl;
+            return false;
+        }
+    }
+#ifdef _WIN32
+    std::remove(path.c_str());  // Windowsのrenameは既存のファイルを上書きしない
+#endif
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "出力ファイルを置き換えられません: " << path << std::endl;
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "使い方: stagec <入力.stage> <出力.stg>" << std::endl;
+        return 1;
+    }
+
+    StageSource stage;
+    if (!Parse(argv[1], stage) || !Write(argv[2], stage)) {
+        return 1;
+    }
+
+    std::cout << argv[2] << ": " << stage.header.width << "x" << stage.header.height << " タイル, 敵 "
+              << stage.enemies.size() << ", アイテム " << stage.items.size() << ", "
+              << stage.header.fileSize << " バイト" << std::endl;
+    return 0;
+}